@@ -29,6 +29,7 @@ Application::Application() :
 	_drawCurveTicks(true), 
 	_drawDeCasteljau(true), 
 	_drawPolygon(true), 
+	_drawIntersections(true), 
 	_mouseHandCursor(glfwCreateStandardCursor(GLFW_HAND_CURSOR)), 
 	_windowWidth(900.0), 
 	_windowHeight(900.0), 
@@ -47,6 +48,7 @@ Application::Application() :
 	_curveTPointColor(ImVec4(1.0f, 0.0f, 0.0f, 1.0f)), 
 	_curveSPointColor(ImVec4(0.0f, 0.0f, 1.0f, 1.0f)),
 	_curveTicksColor(ImVec4(0.0f, 0.0f, 0.0f, 1.0f)), 
+	_intersectionsColor(ImVec4(1.0f, 0.5f, 0.0f, 1.0f)), 
 	_tLeftDomain(0.0f), 
 	_tRightDomain(1.0f), 
 	_sLeftDomain(0.0f), 
@@ -54,14 +56,37 @@ Application::Application() :
 	_deCasteljauT(0.5f), 
 	_sParameter(0.5f), 
 	_nTicks(1), 
+	_arcLengthTicks(false), 
 	_nSegments(200), 
 	_bezierCurves(new std::vector<BezierCurve *>()), 
-	_updateCurve(-1)
+	_bezierBatch(new BezierBatch()), 
+	_curveUpdater(new CurveUpdater()), 
+	_updateCurve(-1), 
+	_dragCurve(-1), 
+	_lastTLeftDomain(0.0f), 
+	_lastTRightDomain(1.0f), 
+	_lastSLeftDomain(0.0f), 
+	_lastSRightDomain(1.0f), 
+	_lastSParameter(0.5f), 
+	_lastNTicks(1), 
+	_lastArcLengthTicks(false), 
+	_lastNSegments(200), 
+	_flatnessTolerance(0.5f), 
+	_lastFlatnessTolerance(ADAPTIVE_FLATNESS_TOLERANCE), 
+	_threadPool(new ThreadPool()), 
+	_curveIntersector(new CurveIntersector()), 
+	_drawableIntersections(NULL), 
+	_curveBVH(new CurveBVH())
 {
 }
 
 Application::~Application()
 {
+	// Stop the worker threads
+	delete _curveBVH;
+	delete _curveIntersector;
+	delete _curveUpdater;
+	delete _threadPool;
 }
 
 void Application::ClearAll()
@@ -85,11 +110,26 @@ void Application::ClearAll()
 	// Indicate the focused Bezier curve is at index 0
 	_focusOnCurve = 0;
 
+	// Build the hierarchy over the new curves vector (its address may be the one of the deleted vector)
+	_curveBVH->Build(_bezierCurves);
+
 	// Indicate no Bezier curve has to be updated
 	_updateCurve = -1;
+	_dragCurve = -1;
 
 	// Indicate the mouse is not over any control point
 	_mouseOnControlPoint = -1;
+
+	// Remove the intersections
+	ClearIntersections();
+}
+
+void Application::ClearIntersections()
+{
+	// Remove the points of the intersections and the versions of their curves
+	std::vector<Point *> noIntersections;
+	_drawableIntersections->DefineGeometry(&noIntersections);
+	_intersectionVersions.clear();
 }
 
 void Application::Draw()
@@ -160,11 +200,11 @@ void Application::Draw()
 					continue;
 				}
 
-				// Get the reference to the current control point
-				Point * p = bezierCurve->_controlPoints->at(j);
+				// Get the current control point
+				Point p = bezierCurve->ControlPointAt(j);
 
 				// Define the model matrix for the current control point
-				const glm::mat4 pointModelMatrix = glm::translate(glm::mat4(), glm::vec3(p->x, p->y, 0.0f));
+				const glm::mat4 pointModelMatrix = glm::translate(glm::mat4(), glm::vec3(p.x, p.y, 0.0f));
 
 				// Draw a square representing the current control point
 				_square->Draw(pointModelMatrix, viewMatrix, projMatrix);
@@ -173,17 +213,22 @@ void Application::Draw()
 			// Draw the square for the dragged point
 			if (_mouseOnControlPoint > -1 && _mouseDragging)
 			{
-				// Get the reference to the dragged control point
-				Point * p = bezierCurve->_controlPoints->at(_mouseOnControlPoint);
+				// Get the dragged control point
+				Point p = bezierCurve->ControlPointAt(_mouseOnControlPoint);
 
 				// Define the model matrix for the dragged control point
-				const glm::mat4 modelMatrix = glm::translate(glm::mat4(), glm::vec3(p->x, p->y, 0.0f));
+				const glm::mat4 modelMatrix = glm::translate(glm::mat4(), glm::vec3(p.x, p.y, 0.0f));
 
 				// Draw a square representing the dragged control point
 				_square->Draw(modelMatrix, viewMatrix, projMatrix);
 			}
 		}
 	}
+
+	// Draw the intersections between the curves
+	_drawableIntersections->SetColor(_intersectionsColor.x, _intersectionsColor.y, _intersectionsColor.z, _intersectionsColor.w);
+	_drawableIntersections->SetDrawing(_drawIntersections);
+	_drawableIntersections->Draw(modelMatrix, viewMatrix, projMatrix);
 }
 
 void Application::DrawUI()
@@ -201,6 +246,7 @@ void Application::DrawUI()
 	ImGui::ColorEdit4("Control Polygon", (float*)&_polygonLinesColor);
 	ImGui::ColorEdit4("De Casteljau", (float*)&_deCasteljauColor);
 	ImGui::ColorEdit4("Convex Hull", (float*)&_convexHullColor);
+	ImGui::ColorEdit4("Intersections", (float*)&_intersectionsColor);
 	ImGui::ColorEdit3("Background", (float*)&_backgroundColor);
 	ImGui::Separator();
 	ImGui::Checkbox("Curve", &_drawCurve); ImGui::SameLine(150);
@@ -254,6 +300,42 @@ void Application::DrawUI()
 	}
 	ImGui::SliderFloat(sRangeC, &_sParameter, _sLeftDomain, _sRightDomain);
 	ImGui::SliderInt("Tick marks", &_nTicks, 1, 100);
+	ImGui::Checkbox("Equal arc length ticks", &_arcLengthTicks);
+	int tessellationMode = (int)_bezierCurves->at(_focusOnCurve)->_tessellationMode;
+	if (ImGui::Combo("Tessellation", &tessellationMode, "De Casteljau\0Forward Differences\0Adaptive\0\0"))
+	{
+		// Change the tessellation mode of the focused Bezier curve and indicate it has to be updated
+		_bezierCurves->at(_focusOnCurve)->_tessellationMode = (TessellationMode)tessellationMode;
+		_bezierCurves->at(_focusOnCurve)->_flatnessTolerance = FlatnessTolerance();
+		_updateCurve = _focusOnCurve;
+	}
+	ImGui::SliderFloat("Flatness (pixels)", &_flatnessTolerance, 0.1f, 10.0f);
+	bool rational = _bezierCurves->at(_focusOnCurve)->_rational;
+	if (ImGui::Checkbox("Rational", &rational))
+	{
+		// Change whether the focused Bezier curve uses the weights of its control points and indicate it has to be updated
+		_bezierCurves->at(_focusOnCurve)->SetRational(rational);
+		_updateCurve = _focusOnCurve;
+	}
+	if (rational && ImGui::TreeNode("Weights"))
+	{
+		// Show the weight of every control point of the focused Bezier curve
+		BezierCurve * focusedCurve = _bezierCurves->at(_focusOnCurve);
+		int nControlPoints = focusedCurve->_controlPoints->size();
+		for (int i = 0; i < nControlPoints; i += 1)
+		{
+			float weight = (float)focusedCurve->_controlPoints->_w[i];
+			ImGui::PushID(i);
+			if (ImGui::DragFloat("w", &weight, 0.01f, 0.01f, 100.0f))
+			{
+				// Change the weight of the control point and indicate the curve has to be updated
+				focusedCurve->SetWeight(i, weight);
+				_updateCurve = _focusOnCurve;
+			}
+			ImGui::PopID();
+		}
+		ImGui::TreePop();
+	}
 	if (ImGui::Button("Restore Defaults")) 
 	{
 		_tLeftDomain = 0.0f;
@@ -263,6 +345,8 @@ void Application::DrawUI()
 		_deCasteljauT = 0.5f;
 		_sParameter = 0.5f;
 		_nTicks = 1;
+		_arcLengthTicks = false;
+		_flatnessTolerance = 0.5f;
 	}
 	ImGui::Separator();
 	ImGui::Text("Curve Operations (For selected curve)");
@@ -285,6 +369,13 @@ void Application::DrawUI()
 		// Subdivide the curve using the current t value
 		Subdivide(_deCasteljauT);
 	}
+	if (ImGui::Button("Find Intersections"))
+	{
+		// Find the intersections among all of the curves
+		FindIntersections();
+	}
+	ImGui::SameLine();
+	ImGui::Checkbox("Show Intersections", &_drawIntersections);
 	ImGui::Separator();
 	ImGui::Text("Display Options");
 	if (ImGui::Button("Clear All"))
@@ -311,6 +402,12 @@ void Application::DrawUI()
 		// Save the curves in a text file
 		WriteFile();
 	}
+	ImGui::SameLine();
+	if (ImGui::Button("Export Points")) 
+	{
+		// Save the curve points in a text file
+		ExportCurvePoints();
+	}
 	ImGui::Separator();
 	ImGui::Text(mouseAtChar);
 	ImGui::End();
@@ -327,34 +424,104 @@ void Application::DrawUI()
 	}
 }
 
-int Application::MouseOnControlPoint()
+void Application::ExportCurvePoints()
 {
-	// Get the reference to the focused Bezier curve
-	BezierCurve * bezierCurve = _bezierCurves->at(_focusOnCurve);
+	// The filter for txt files
+	const char * filePatterns[1] = { "*.txt" };
 
-	// Get the number of control points
-	int nControlPoints = bezierCurve->_controlPoints->size();
+	// Get the file name
+	const char * filename = tinyfd_saveFileDialog("Export curve points", "curvepoints.txt", 1, filePatterns, NULL);
 
-	// Traverse through the control points
-	for (int i = 0; i < nControlPoints; i += 1)
+	// If a filename is given then store the curve points
+	if (filename) 
 	{
-		// Get the reference to the current control point
-		Point * p = bezierCurve->_controlPoints->at(i);
+		// The file object
+		std::ofstream file;
 
-		// Return the current index if the mouse coordinates are within the current control point rect
-		if (
-			_mouseX >= p->x - _square->_halfSize &&
-			_mouseX <= p->x + _square->_halfSize &&
-			_mouseY >= p->y - _square->_halfSize &&
-			_mouseY <= p->y + _square->_halfSize)
+		// Open the file
+		file.open(filename);
+
+		// Get the number of Bezier curves
+		int nBezierCurves = _bezierCurves->size();
+
+		// Write the number of bezier curves found
+		file << "arcs <" << nBezierCurves << ">" << '\t' << "# number of arcs following" << '\n';
+
+		// The arrays where the curve points are calculated
+		std::vector<double> curveX(_nSegments + 1);
+		std::vector<double> curveY(_nSegments + 1);
+
+		// Traverse through the bezier curves and write down their curve points
+		for (int i = 0; i < nBezierCurves; i += 1)
 		{
-			// Return the index of the control point
-			return i;
+			// Get the reference to the current Bezier curve
+			BezierCurve * bezierCurve = _bezierCurves->at(i);
+
+			// Calculate the curve points (a curve without control points has no points)
+			int nCurvePoints = bezierCurve->_controlPoints->size() > 0 ? _nSegments + 1 : 0;
+			if (nCurvePoints > 0) 
+			{
+				bezierCurve->Sample(_tLeftDomain, _tRightDomain, _nSegments, curveX.data(), curveY.data());
+			}
+
+			// Write the number of curve points of the current curve
+			file << "points <" << nCurvePoints << ">" << '\t' << "# number of curve points following" << '\n';
+
+			// Traverse through the curve points
+			for (int j = 0; j < nCurvePoints; j += 1)
+			{
+				// Write the current curve point (only x and y)
+				file << "<" << curveX[j] << " " << curveY[j] << ">" << '\n';
+			}
+
+			// Write the end of the points
+			file << "endpoints" << '\t' << "# terminates the curve points" << '\n';
 		}
+
+		// Close the file
+		file.close();
 	}
+}
 
-	// The mouse was not found over any control point, then return -1
-	return -1;
+void Application::FindIntersections()
+{
+	// Find the intersections among all of the curves
+	std::vector<CurveIntersection> * intersections = _curveIntersector->IntersectAll(_bezierCurves, _threadPool);
+
+	// Get the number of intersections
+	int nIntersections = intersections->size();
+
+	// Store the versions of the curves, so the intersections are removed when the curves change
+	int nCurves = _bezierCurves->size();
+	_intersectionVersions.clear();
+	for (int i = 0; i < nCurves; i += 1)
+	{
+		_intersectionVersions.push_back(std::make_pair((const BezierCurve *)_bezierCurves->at(i), _bezierCurves->at(i)->_version));
+	}
+
+	// Store the points of the intersections and define their geometry
+	std::vector<Point *> * points = new std::vector<Point *>();
+	for (int i = 0; i < nIntersections; i += 1)
+	{
+		points->push_back(new Point(intersections->at(i)._x, intersections->at(i)._y));
+	}
+	_drawableIntersections->DefineGeometry(points);
+
+	// Delete the vectors
+	Utils::DeletePointVector(points);
+	delete intersections;
+}
+
+double Application::FlatnessTolerance()
+{
+	// Scale the tolerance by the width of a pixel
+	return (double)_flatnessTolerance * (double)(_orthoRight - _orthoLeft) / _windowWidth;
+}
+
+int Application::MouseOnControlPoint()
+{
+	// Find the control point of the focused Bezier curve whose square contains the mouse coordinates
+	return _bezierCurves->at(_focusOnCurve)->FindControlPoint(_mouseX, _mouseY, _square->_halfSize);
 }
 
 void Application::Init()
@@ -367,6 +534,30 @@ void Application::Init()
 
 	// Generate a new square
 	_square = new Square(0.04);
+
+	// Generate the drawable for the intersections
+	_drawableIntersections = new DrawablePoints();
+}
+
+bool Application::IntersectionsUpToDate()
+{
+	// The intersections are outdated if a curve was added or deleted
+	int nCurves = _bezierCurves->size();
+	if ((int)_intersectionVersions.size() != nCurves)
+	{
+		return false;
+	}
+
+	// The intersections are outdated if any curve was replaced or changed (e.g. dragged, subdivided or weighted)
+	for (int i = 0; i < nCurves; i += 1)
+	{
+		if (_intersectionVersions[i].first != _bezierCurves->at(i) || _intersectionVersions[i].second != _bezierCurves->at(i)->_version)
+		{
+			return false;
+		}
+	}
+
+	return true;
 }
 
 void Application::OpenFile()
@@ -457,7 +648,24 @@ void Application::OpenFile()
 				std::cout << "double (" << x << ", " << y << ")" << std::endl;
 
 				// Generate a new point ans push it into the control points for the new current curve
-				currentCurve->_controlPoints->push_back(new Point(x, y));
+				currentCurve->AddControlPoint(x, y);
+
+				// Get the optional weight of the point (trim blanks and <>), if there is one then the curve is rational
+				std::string sw = (tokens.size() > 2) ? tokens.at(2) : "";
+				Utils::trim_inplace(sw);
+				Utils::trim_inplace(sw, "<>");
+				if (!sw.empty()) 
+				{
+					// Weights that are not positive are ignored (the point keeps weight 1)
+					if (currentCurve->SetWeight(currentCurve->_controlPoints->size() - 1, std::stod(sw))) 
+					{
+						currentCurve->SetRational(true);
+					}
+					else 
+					{
+						std::cout << "Ignoring the weight " << sw << " (weights must be positive)" << std::endl;
+					}
+				}
 			}
 		}
 
@@ -469,6 +677,9 @@ void Application::OpenFile()
 
 		std::cout << "Generated " << nCurves << " curves" << std::endl;
 
+		// Calculate the curve points of all of the new curves at once
+		_bezierBatch->Tessellate(&curves, _tLeftDomain, _tRightDomain, _nSegments);
+
 		// Get tne index for the new curve (it is the size of the number of stored curves)
 		int newCurveIndex = _bezierCurves->size();
 
@@ -481,8 +692,8 @@ void Application::OpenFile()
 			// Delete the reference to the new curve from the curves vector (we don't want to loose it)
 			curves.at(i) = NULL;
 
-			// Update the visualization of the new Bezier curve
-			_bezierCurves->at(newCurveIndex)->Update((float)_tLeftDomain, (float)_tRightDomain, _nSegments);
+			// Update the visualization of the new Bezier curve using its calculated curve points
+			_bezierCurves->at(newCurveIndex)->UpdateGeometry((float)_tLeftDomain, (float)_tRightDomain);
 			_bezierCurves->at(newCurveIndex)->UpdateDeCasteljau(_deCasteljauT);
 
 			// Increment the index for the next new curve
@@ -494,6 +705,15 @@ void Application::OpenFile()
 	}
 }
 
+int Application::PickCurve()
+{
+	// Refit the hierarchy to the edited curves
+	_curveBVH->Update(_bezierCurves);
+
+	// Return the curve nearest to the mouse
+	return _curveBVH->NearestCurve(_mouseX, _mouseY, 2.0 * _square->_halfSize, NULL);
+}
+
 void Application::SaveImage()
 {
 	// The filter for tiff files
@@ -556,6 +776,20 @@ void Application::Subdivide(double t)
 
 void Application::Update()
 {
+	// If the parametric domain, the segments, the flatness tolerance, the ticks or the s parameter have changed then update all of the curves at once
+	if (_lastTLeftDomain != _tLeftDomain || _lastTRightDomain != _tRightDomain || _lastNSegments != _nSegments || _lastFlatnessTolerance != FlatnessTolerance() || 
+		_lastNTicks != _nTicks || _lastArcLengthTicks != _arcLengthTicks || 
+		_lastSParameter != _sParameter || _lastSLeftDomain != _sLeftDomain || _lastSRightDomain != _sRightDomain) 
+	{
+		UpdateAllCurves();
+	}
+
+	// If there are intersections on the screen and the curves changed since they were found then remove them
+	if (!_intersectionVersions.empty() && !IntersectionsUpToDate())
+	{
+		ClearIntersections();
+	}
+
 	// If the focused Bezier curve has less than two points then exit the function
 	// NOTE: There is nothing we can do
 	if (_bezierCurves->at(_focusOnCurve)->_controlPoints->size() < 2) 
@@ -577,10 +811,10 @@ void Application::Update()
 	}
 
 	// If the focused curve has stored a different tick value then update it
-	if (_bezierCurves->at(_focusOnCurve)->_nTicks != _nTicks) 
+	if (_bezierCurves->at(_focusOnCurve)->_nTicks != _nTicks || _bezierCurves->at(_focusOnCurve)->_arcLengthTicks != _arcLengthTicks) 
 	{
 		// Update the ticks on the curve
-		_bezierCurves->at(_focusOnCurve)->UpdateTicks(_nTicks);
+		_bezierCurves->at(_focusOnCurve)->UpdateTicks(_nTicks, _arcLengthTicks);
 	}
 
 	// If the focused curve has stored a different s paramter then update the point
@@ -592,6 +826,30 @@ void Application::Update()
 	}
 }
 
+void Application::UpdateAllCurves()
+{
+	// Get the flatness tolerance in world units
+	double flatnessTolerance = FlatnessTolerance();
+
+	// Calculate the curve points, the convex hulls, the ticks and the reparametrized points of all of the curves using the thread pool
+	_curveUpdater->Compute(_bezierCurves, _threadPool, _tLeftDomain, _tRightDomain, _nSegments, flatnessTolerance, _nTicks, _arcLengthTicks, 
+		_sParameter, _sLeftDomain, _sRightDomain);
+
+	// Redefine the geometry of the curves
+	_curveUpdater->Upload(_bezierCurves, _tLeftDomain, _tRightDomain);
+
+	// Store the values used for updating the curves
+	_lastTLeftDomain = _tLeftDomain;
+	_lastTRightDomain = _tRightDomain;
+	_lastNSegments = _nSegments;
+	_lastFlatnessTolerance = flatnessTolerance;
+	_lastNTicks = _nTicks;
+	_lastArcLengthTicks = _arcLengthTicks;
+	_lastSParameter = _sParameter;
+	_lastSLeftDomain = _sLeftDomain;
+	_lastSRightDomain = _sRightDomain;
+}
+
 void Application::UpdateCurve()
 {
 	// If there is a curve to be updated
@@ -601,11 +859,30 @@ void Application::UpdateCurve()
 		_bezierCurves->at(_updateCurve)->Update((float)_tLeftDomain, (float)_tRightDomain, _nSegments);
 		_bezierCurves->at(_updateCurve)->UpdateDeCasteljau(_deCasteljauT);
 		_bezierCurves->at(_updateCurve)->UpdateSPoint(_sParameter, _sLeftDomain, _sRightDomain);
-		_bezierCurves->at(_updateCurve)->UpdateTicks(_nTicks);
+		_bezierCurves->at(_updateCurve)->UpdateTicks(_nTicks, _arcLengthTicks);
+
+		// If the same curve was dragged then its geometry is already up to date
+		if (_dragCurve == _updateCurve) 
+		{
+			_dragCurve = -1;
+		}
 
 		// Indicate the curve no longer requires to be updated
 		_updateCurve = -1;
 	}
+
+	// If there is a curve whose curve points were updated while dragging
+	if (_dragCurve > -1) 
+	{
+		// Update the bezier curve elements without calculating the curve points again
+		_bezierCurves->at(_dragCurve)->UpdateGeometry((float)_tLeftDomain, (float)_tRightDomain);
+		_bezierCurves->at(_dragCurve)->UpdateDeCasteljau(_deCasteljauT);
+		_bezierCurves->at(_dragCurve)->UpdateSPoint(_sParameter, _sLeftDomain, _sRightDomain);
+		_bezierCurves->at(_dragCurve)->UpdateTicks(_nTicks, _arcLengthTicks);
+
+		// Indicate the curve no longer requires to be updated
+		_dragCurve = -1;
+	}
 }
 
 void Application::WriteFile()
@@ -646,11 +923,18 @@ void Application::WriteFile()
 			// Traverse through the control points of the curve
 			for (int j = 0; j < nControlPoints; j += 1)
 			{
-				// Get the reference to the current control point
-				Point * p = bezierCurve->_controlPoints->at(j);
+				// Get the current control point
+				Point p = bezierCurve->ControlPointAt(j);
 
-				// Write the current control point (only x and y)
-				file << "<" << p->x << " " << p->y << ">" << '\t' << "# control point as two floats separated by blank" << '\n';
+				// Write the current control point (x, y and the weight for rational curves)
+				if (bezierCurve->_rational) 
+				{
+					file << "<" << p.x << " " << p.y << " " << p.w << ">" << '\t' << "# control point and weight as three floats separated by blank" << '\n';
+				}
+				else 
+				{
+					file << "<" << p.x << " " << p.y << ">" << '\t' << "# control point as two floats separated by blank" << '\n';
+				}
 			}
 
 			// Write the end of the arc
@@ -693,16 +977,18 @@ void Application::CursorPosCallback(GLFWwindow * window, double xpos, double ypo
 	// If the mouse is dragging then we know it is over a control point
 	if (app->_mouseDragging)
 	{
-		// Get the reference to the dragged point
-		Point * p = app->_bezierCurves->at(app->_focusOnCurve)->_controlPoints->at(app->_mouseOnControlPoint);
-
-		// Update the point coordinates
-		p->x = app->_mouseX;
-		p->y = app->_mouseY;
-
-		// Indicate the curve points have to be updated
-		// NOTE: This is required since a control point has been dragged
-		app->_updateCurve = app->_focusOnCurve;
+		// Move the dragged point, the curve points are updated with the displacement when possible
+		if (app->_bezierCurves->at(app->_focusOnCurve)->MoveControlPoint(app->_mouseOnControlPoint, app->_mouseX, app->_mouseY)) 
+		{
+			// Indicate only the geometry of the curve has to be updated
+			app->_dragCurve = app->_focusOnCurve;
+		}
+		else 
+		{
+			// Indicate the curve points have to be updated
+			// NOTE: This is required since a control point has been dragged
+			app->_updateCurve = app->_focusOnCurve;
+		}
 	}
 	else 
 	{
@@ -794,6 +1080,16 @@ void Application::MouseButtonCallback(GLFWwindow * window, int button, int actio
 			// NOTE: This is required since a control point has been deleted
 			app->_updateCurve = app->_focusOnCurve;
 		}
+
+		// Otherwise focus on the curve under the mouse (if any)
+		else 
+		{
+			int pickedCurve = app->PickCurve();
+			if (pickedCurve > -1) 
+			{
+				app->_focusOnCurve = pickedCurve;
+			}
+		}
 	}
 }
 
@@ -811,6 +1107,25 @@ void Application::WindowSizeCallback(GLFWwindow * window, int width, int height)
 
 int Application::Run(int argc, char ** argv)
 {
+	// Get the start time for measuring the time to the first frame
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+	// Disable the shader binary cache if requested (for comparing the time to the first frame)
+	bool shaderCache = true;
+	for (int i = 1; i < argc; i += 1) 
+	{
+		if (std::string(argv[i]) == "--no-shader-cache") 
+		{
+			shaderCache = false;
+		}
+	}
+	ShaderProgram::SetBinaryCache(shaderCache);
+
+	// Store the shader binary cache next to the executable, so it does not depend on the working directory
+	std::string executable = (argc > 0) ? argv[0] : "";
+	size_t separator = executable.find_last_of("/\\");
+	ShaderProgram::SetCacheDirectory((separator != std::string::npos) ? executable.substr(0, separator + 1) : "");
+
 	// Initialize glfw (exit if any error occur)
 	if (!glfwInit()) 
 	{
@@ -861,10 +1176,11 @@ int Application::Run(int argc, char ** argv)
 	app->Init();
 
 	// Loop until the user closes the window
+	bool firstFrame = true;
 	while (!glfwWindowShouldClose(app->_window))
 	{
 		// If the there is a curve to be updated then do it
-		if (app->_updateCurve > -1) 
+		if (app->_updateCurve > -1 || app->_dragCurve > -1) 
 		{
 			app->UpdateCurve();
 		}
@@ -881,6 +1197,19 @@ int Application::Run(int argc, char ** argv)
 		// Swap front and back buffers
 		glfwSwapBuffers(app->_window);
 
+		// Write the time to the first frame
+		if (firstFrame) 
+		{
+			glFinish();
+			std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+			int loaded = 0;
+			int compiled = 0;
+			ShaderProgram::GetCacheCounts(loaded, compiled);
+			std::cout << "First frame in " << std::chrono::duration<double, std::milli>(end - start).count() << " ms (shader binary cache " << 
+				(shaderCache ? "enabled" : "disabled") << ", " << loaded << " programs loaded from the cache, " << compiled << " compiled)" << std::endl;
+			firstFrame = false;
+		}
+
 		// Poll for and process events
 		glfwPollEvents();
 	}
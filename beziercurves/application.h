@@ -6,7 +6,12 @@
 #include <GL\gl3w.h>
 #include <GLFW\glfw3.h>
 #include "imgui.h"
+#include "bezier_batch.h"
 #include "bezier_curve.h"
+#include "curve_bvh.h"
+#include "curve_intersector.h"
+#include "curve_updater.h"
+#include "drawable_points.h"
 #include "square.h"
 #include <memory>
 
@@ -60,6 +65,9 @@ public:
 	// Indicate whether to draw the polygons
 	bool _drawPolygon;
 
+	// Indicate whether to draw the intersections between the curves
+	bool _drawIntersections;
+
 	// The hand cursor shape
 	GLFWcursor * _mouseHandCursor;
 
@@ -117,21 +125,39 @@ public:
 	// The color for the curve ticks
 	ImVec4 _curveTicksColor;
 
+	// The color for the intersections between the curves
+	ImVec4 _intersectionsColor;
+
 	// The vector containing the Bezier curves
 	std::vector<BezierCurve *> * _bezierCurves;
 
+	// The batch for calculating the curve points of many curves at once
+	BezierBatch * _bezierBatch;
+
+	// The updater of every curve of the scene at once
+	CurveUpdater * _curveUpdater;
+
 	// The square for drawing the points
 	Square * _square;
 
 	// The indez of the Bezier curve to be updated
 	int _updateCurve;
 
+	// The index of the Bezier curve whose curve points were updated while dragging a control point (only its geometry is updated)
+	int _dragCurve;
+
 	// The value for the left parametric domain
 	float _tLeftDomain;
 
 	// The value for the right parametric domain
 	float _tRightDomain;
 
+	// The left parametric domain used the last time all of the curves were updated
+	float _lastTLeftDomain;
+
+	// The right parametric domain used the last time all of the curves were updated
+	float _lastTRightDomain;
+
 	// The value for the left reparametrized domain
 	float _sLeftDomain;
 
@@ -144,12 +170,54 @@ public:
 	// The s paramter for drawing the reparametrized DeCasteljau
 	float _sParameter;
 
+	// The left reparametrized domain used the last time all of the curves were updated
+	float _lastSLeftDomain;
+
+	// The right reparametrized domain used the last time all of the curves were updated
+	float _lastSRightDomain;
+
+	// The s parameter used the last time all of the curves were updated
+	float _lastSParameter;
+
 	// The number of ticks to be drawn over the curves
 	int _nTicks;
 
+	// Indicates whether the ticks are placed at equal arc lengths
+	bool _arcLengthTicks;
+
+	// The number of ticks used the last time all of the curves were updated
+	int _lastNTicks;
+
+	// Indicates whether the ticks were placed at equal arc lengths the last time all of the curves were updated
+	bool _lastArcLengthTicks;
+
 	// The number of segments for drawing the curves
 	int _nSegments;
 
+	// The number of segments used the last time all of the curves were updated
+	int _lastNSegments;
+
+	// The flatness tolerance (in pixels) for the curves using the adaptive tessellation
+	float _flatnessTolerance;
+
+	// The flatness tolerance (in world units) used the last time all of the curves were updated
+	double _lastFlatnessTolerance;
+
+	// The pool of threads for the work split among the curves
+	ThreadPool * _threadPool;
+
+	// The intersector finding the intersections between the curves
+	CurveIntersector * _curveIntersector;
+
+	// The drawable points representing the intersections between the curves
+	DrawablePoints * _drawableIntersections;
+
+	// The curves and their versions when the intersections were found (the intersections are removed when any of them changes)
+	std::vector<std::pair<const BezierCurve *, int>> _intersectionVersions;
+
+	// The bounding volume hierarchy over the curves used for picking them
+	CurveBVH * _curveBVH;
+
 	// A static reference to the instance of the application
 	static std::shared_ptr<Application> _staticInstance;
 
@@ -168,6 +236,11 @@ public:
 	*/
 	void ClearAll();
 
+	/*
+	Removes the intersections from the screen.
+	*/
+	void ClearIntersections();
+
 	/*
 	Renders the content of the application.
 	*/
@@ -184,16 +257,46 @@ public:
 	*/
 	int MouseOnControlPoint();
 
+	/*
+	Writes the curve points of the current curves (sampled in the current parametric domain) on a text file.
+	*/
+	void ExportCurvePoints();
+
+	/*
+	Finds the intersections among all of the curves and defines the geometry of their points.
+	*/
+	void FindIntersections();
+
+	/*
+	Returns the flatness tolerance for the adaptive tessellation in world units. The tolerance in pixels is scaled by the width 
+	of a pixel in the orthogonal viewing domain.
+	@return double The flatness tolerance in world units
+	*/
+	double FlatnessTolerance();
+
 	/*
 	Initialize the objects of the application.
 	*/
 	void Init();
 
+	/*
+	Indicates whether the intersections on the screen still belong to the current curves, this is, no curve has been added, 
+	deleted or changed since they were found.
+	@return bool If the intersections are up to date
+	*/
+	bool IntersectionsUpToDate();
+
 	/*
 	Opens and processess the given file. Bezier curves are stored directly in the Bezier curves vector
 	*/
 	void OpenFile();
 
+	/*
+	Returns the index of the curve nearest to the mouse, as long as it is within the width of a control point square.
+	@return int The index of the nearest curve, or -1 if there is no curve near the mouse
+	*/
+	int PickCurve();
+
 	/*
 	Saves the current screenshot as a tif image. It is used DevIL SDK for Windows (http://openil.sourceforge.net/) 
 	for generating the images. Check http://downloads.sourceforge.net/openil/DevIL-Windows-SDK-1.8.0.zip for the SDK.
@@ -212,6 +315,13 @@ public:
 	*/
 	void Update();
 
+	/*
+	Updates every curve of the scene at once using the current parametric domain, segments, flatness tolerance, ticks and s
+	parameter. The curve points (of the curves that need them), the convex hulls, the ticks and the reparametrized points are
+	calculated by the thread pool, and then the drawables are updated on the calling thread (see CurveUpdater).
+	*/
+	void UpdateAllCurves();
+
 	/*
 	Updates the buffers that store the elements for the shaders
 	*/
@@ -0,0 +1,172 @@
+#include "bernstein_basis.h"
+#include "bounded_cache.h"
+#include "simd.h"
+#include <tuple>
+
+// The number of SIMD registers of rows accumulated at once by the product
+const int BASIS_BLOCK_REGISTERS = 4;
+
+// The key of the basis matrices (number of control points, left domain, right domain, segments)
+typedef std::tuple<int, double, double, int> BernsteinBasisKey;
+
+BernsteinBasis::BernsteinBasis(int nPoints, double x, double y, int segments) :
+	_nPoints(nPoints),
+	_x(x),
+	_y(y),
+	_segments(segments)
+{
+	// Get the number of rows and make room for the values
+	int nRows = segments + 1;
+	_values.resize(nRows * nPoints);
+
+	// The parameter step and the Bernstein values at the current parameter
+	double tStep = (y - x) / (double)segments;
+	std::vector<double> basis(nPoints);
+
+	// Traverse through the rows
+	for (int j = 0; j < nRows; j += 1)
+	{
+		// The parameter of the current row (the last one uses y as is, so the curve end is exact)
+		double t = (j == segments) ? y : x + (j * tStep);
+
+		// Calculate the Bernstein values at t using the DeCasteljau recurrence
+		double _t = 1.0 - t;
+		basis[0] = 1.0;
+		for (int k = 1; k < nPoints; k += 1)
+		{
+			basis[k] = t * basis[k - 1];
+			for (int i = k - 1; i > 0; i -= 1)
+			{
+				basis[i] = (_t * basis[i]) + (t * basis[i - 1]);
+			}
+			basis[0] = _t * basis[0];
+		}
+
+		// Store the values in their columns
+		for (int i = 0; i < nPoints; i += 1)
+		{
+			_values[(i * nRows) + j] = basis[i];
+		}
+	}
+}
+
+BernsteinBasis::~BernsteinBasis()
+{
+}
+
+const double * BernsteinBasis::Column(int index) const
+{
+	return _values.data() + (index * (_segments + 1));
+}
+
+void BernsteinBasis::Multiply(const double * coordinates, int nColumns, double * const * out, int firstRow, int lastRow) const
+{
+	// Get the number of rows, the last row to be calculated and the number of rows per block
+	int nRows = _segments + 1;
+	lastRow = (lastRow < 0 || lastRow > nRows) ? nRows : lastRow;
+	const int blockRows = BASIS_BLOCK_REGISTERS * Simd::LANES;
+
+	// Traverse through the full blocks of rows
+	int r = firstRow;
+	for (; r + blockRows <= lastRow; r += blockRows)
+	{
+		// Traverse through the columns, two at a time so every load of the basis is used twice
+		int c = 0;
+		for (; c + 1 < nColumns; c += 2)
+		{
+			// Get the coordinates of both columns
+			const double * first = coordinates + (c * _nPoints);
+			const double * second = first + _nPoints;
+
+			// The accumulated products of the block
+			Simd::Double firstSum[BASIS_BLOCK_REGISTERS];
+			Simd::Double secondSum[BASIS_BLOCK_REGISTERS];
+			for (int k = 0; k < BASIS_BLOCK_REGISTERS; k += 1)
+			{
+				firstSum[k] = Simd::Set1(0.0);
+				secondSum[k] = Simd::Set1(0.0);
+			}
+
+			// Add the contribution of every control point
+			for (int i = 0; i < _nPoints; i += 1)
+			{
+				const double * b = _values.data() + (i * nRows) + r;
+				Simd::Double vFirst = Simd::Set1(first[i]);
+				Simd::Double vSecond = Simd::Set1(second[i]);
+				for (int k = 0; k < BASIS_BLOCK_REGISTERS; k += 1)
+				{
+					Simd::Double vb = Simd::Load(b + (k * Simd::LANES));
+					firstSum[k] = Simd::MulAdd(vb, vFirst, firstSum[k]);
+					secondSum[k] = Simd::MulAdd(vb, vSecond, secondSum[k]);
+				}
+			}
+
+			// Store the products of the block
+			for (int k = 0; k < BASIS_BLOCK_REGISTERS; k += 1)
+			{
+				Simd::Store(out[c] + r + (k * Simd::LANES), firstSum[k]);
+				Simd::Store(out[c + 1] + r + (k * Simd::LANES), secondSum[k]);
+			}
+		}
+
+		// Multiply the last column if the number of columns is odd
+		if (c < nColumns)
+		{
+			const double * column = coordinates + (c * _nPoints);
+
+			Simd::Double sum[BASIS_BLOCK_REGISTERS];
+			for (int k = 0; k < BASIS_BLOCK_REGISTERS; k += 1)
+			{
+				sum[k] = Simd::Set1(0.0);
+			}
+
+			for (int i = 0; i < _nPoints; i += 1)
+			{
+				const double * b = _values.data() + (i * nRows) + r;
+				Simd::Double v = Simd::Set1(column[i]);
+				for (int k = 0; k < BASIS_BLOCK_REGISTERS; k += 1)
+				{
+					sum[k] = Simd::MulAdd(Simd::Load(b + (k * Simd::LANES)), v, sum[k]);
+				}
+			}
+
+			for (int k = 0; k < BASIS_BLOCK_REGISTERS; k += 1)
+			{
+				Simd::Store(out[c] + r + (k * Simd::LANES), sum[k]);
+			}
+		}
+	}
+
+	// Multiply the remaining rows one at a time
+	for (int c = 0; c < nColumns; c += 1)
+	{
+		const double * column = coordinates + (c * _nPoints);
+		for (int j = r; j < lastRow; j += 1)
+		{
+			double sum = 0.0;
+			for (int i = 0; i < _nPoints; i += 1)
+			{
+				sum += _values[(i * nRows) + j] * column[i];
+			}
+			out[c][j] = sum;
+		}
+	}
+}
+
+std::shared_ptr<const BernsteinBasis> BernsteinBasis::Get(int nPoints, double x, double y, int segments)
+{
+	// The cached matrices
+	static BoundedCache<BernsteinBasisKey, BernsteinBasis> cache(BERNSTEIN_BASIS_CACHE_SIZE);
+
+	// Return the cached matrix if it exists
+	BernsteinBasisKey key(nPoints, x, y, segments);
+	std::shared_ptr<const BernsteinBasis> cached = cache.Find(key);
+	if (cached)
+	{
+		return cached;
+	}
+
+	// Build the new matrix outside of the lock and store it
+	std::shared_ptr<const BernsteinBasis> basis(new BernsteinBasis(nPoints, x, y, segments));
+	return cache.Insert(key, basis);
+}
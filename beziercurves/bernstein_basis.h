@@ -0,0 +1,85 @@
+#pragma once
+
+#ifndef _BERNSTEIN_BASIS_H_
+#define _BERNSTEIN_BASIS_H_
+
+#include <memory>
+#include <vector>
+
+// The maximum number of cached basis matrices (dragging the domain generates a new one on every frame)
+const int BERNSTEIN_BASIS_CACHE_SIZE = 64;
+
+/*
+The class representing the Bernstein basis matrix of a tessellation, this is, the values of the Bernstein polynomials of
+nPoints control points at the segments + 1 parameters of the domain [x, y]. The curve points are the product of the matrix
+and the control points, so a single matrix serves every curve with the same number of control points, domain and segments.
+The matrix is stored column by column: column i holds B_i(t_0), B_i(t_1), ..., B_i(t_segments).
+*/
+class BernsteinBasis
+{
+
+public:
+
+	// The number of control points
+	int _nPoints;
+
+	// The left value of the parameter domain
+	double _x;
+
+	// The right value of the parameter domain
+	double _y;
+
+	// The number of segments of the tessellation
+	int _segments;
+
+	// The values of the matrix, (segments + 1) x nPoints stored by columns
+	std::vector<double> _values;
+
+	/*
+	Constructor of the class. Calculates the values of the matrix.
+	NOTE: The parameters are t_j = x + j * (y - x) / segments, except the last one which is y as is.
+	@param int nPoints The number of control points
+	@param double x The left value of the parameter domain
+	@param double y The right value of the parameter domain
+	@param int segments The number of segments of the tessellation
+	*/
+	BernsteinBasis(int nPoints, double x, double y, int segments);
+
+	/*
+	Destructor of the class
+	*/
+	~BernsteinBasis();
+
+	/*
+	Returns the column of the matrix with the values of the Bernstein polynomial of the given control point.
+	@param int index The index of the control point
+	@return const double * The pointer to the segments + 1 values of the column
+	*/
+	const double * Column(int index) const;
+
+	/*
+	Multiplies the matrix by a matrix of control point coordinates. The product runs over blocks of rows kept in SIMD registers,
+	and every block of the basis is reused for all of the columns while it is in cache.
+	@param const double * coordinates The coordinates, nColumns arrays of nPoints values one after the other (e.g. the X and Y
+	coordinates of one or more curves)
+	@param int nColumns The number of arrays of coordinates
+	@param double * const * out The arrays where the products are stored, one per array of coordinates (segments + 1 values each)
+	@param int firstRow The first row of the product to be calculated (so a product can be split among threads)
+	@param int lastRow The last row of the product to be calculated (exclusive, -1 calculates up to the last row)
+	*/
+	void Multiply(const double * coordinates, int nColumns, double * const * out, int firstRow = 0, int lastRow = -1) const;
+
+	/*
+	Returns the basis matrix for the given values. Matrices are built the first time they are requested and shared by the whole
+	process (up to BERNSTEIN_BASIS_CACHE_SIZE of them).
+	@param int nPoints The number of control points
+	@param double x The left value of the parameter domain
+	@param double y The right value of the parameter domain
+	@param int segments The number of segments of the tessellation
+	@return std::shared_ptr<const BernsteinBasis> The pointer to the basis matrix
+	*/
+	static std::shared_ptr<const BernsteinBasis> Get(int nPoints, double x, double y, int segments);
+
+};
+
+#endif
@@ -0,0 +1,121 @@
+#include "bezier_batch.h"
+#include <map>
+
+BezierBatch::BezierBatch()
+{
+}
+
+BezierBatch::~BezierBatch()
+{
+}
+
+int BezierBatch::RaiseToCommonDegree(std::vector<BezierCurve *> * curves)
+{
+	// Get the number of curves
+	int nCurves = curves->size();
+
+	// Find the highest number of control points
+	int nCommonPoints = 0;
+	for (int i = 0; i < nCurves; i += 1)
+	{
+		int nPoints = curves->at(i)->_controlPoints->size();
+		if (nPoints > 1 && nPoints > nCommonPoints)
+		{
+			nCommonPoints = nPoints;
+		}
+	}
+
+	// Raise the degree of every curve to the common one
+	for (int i = 0; i < nCurves; i += 1)
+	{
+		int nPoints = curves->at(i)->_controlPoints->size();
+		if (nPoints > 1 && nPoints < nCommonPoints)
+		{
+			curves->at(i)->RaiseDegreeBy(nCommonPoints - nPoints);
+		}
+	}
+
+	// Return the common number of control points
+	return nCommonPoints;
+}
+
+void BezierBatch::Tessellate(std::vector<BezierCurve *> * curves, double x, double y, int segments)
+{
+	// The groups of curves, indexed by their number of control points
+	std::map<int, std::vector<BezierCurve *>> groups;
+
+	// Get the number of curves
+	int nCurves = curves->size();
+
+	// Traverse through the curves
+	for (int i = 0; i < nCurves; i += 1)
+	{
+		// Get the reference to the current curve
+		BezierCurve * curve = curves->at(i);
+
+		// Ignore the curve if it has no curve points
+		if (curve->_controlPoints->size() < 2)
+		{
+			continue;
+		}
+
+		// If the curve is rational or not tessellated with DeCasteljau's algorithm then tessellate it individually
+		if (curve->_rational || curve->_tessellationMode != TESSELLATION_DECASTELJAU)
+		{
+			curve->Tessellate(x, y, segments);
+			continue;
+		}
+
+		// Make room for the curve points
+		curve->_curveX.resize(segments + 1);
+		curve->_curveY.resize(segments + 1);
+
+		// Add the curve to the group with its number of control points
+		groups[curve->_controlPoints->size()].push_back(curve);
+	}
+
+	// Tessellate every group
+	for (std::map<int, std::vector<BezierCurve *>>::iterator it = groups.begin(); it != groups.end(); ++it)
+	{
+		TessellateGroup(it->second, it->first, x, y, segments);
+	}
+}
+
+void BezierBatch::TessellateGroup(std::vector<BezierCurve *> & group, int nPoints, double x, double y, int segments)
+{
+	// Get the number of curves
+	int nCurves = group.size();
+
+	// Get the shared basis matrix of the group
+	std::shared_ptr<const BernsteinBasis> basis = BernsteinBasis::Get(nPoints, x, y, segments);
+
+	// Make room for the coordinates and the outputs (two columns per curve)
+	_coordinates.resize(2 * nCurves * nPoints);
+	_outputs.resize(2 * nCurves);
+
+	// Stack the X and Y coordinates of the control points of every curve, along with the arrays where their curve points are stored
+	for (int c = 0; c < nCurves; c += 1)
+	{
+		BezierCurve * curve = group.at(c);
+		double * coordinatesX = _coordinates.data() + (2 * c * nPoints);
+		double * coordinatesY = coordinatesX + nPoints;
+		for (int i = 0; i < nPoints; i += 1)
+		{
+			coordinatesX[i] = curve->_controlPoints->_x[i];
+			coordinatesY[i] = curve->_controlPoints->_y[i];
+		}
+
+		_outputs[2 * c] = curve->_curveX.data();
+		_outputs[(2 * c) + 1] = curve->_curveY.data();
+	}
+
+	// Multiply the basis matrix by the stacked control points
+	basis->Multiply(_coordinates.data(), 2 * nCurves, _outputs.data());
+
+	// Indicate the curve points of every curve match their control points
+	for (int c = 0; c < nCurves; c += 1)
+	{
+		group.at(c)->_basis = basis;
+		group.at(c)->_curveVersion = group.at(c)->_version;
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#ifndef _BEZIER_BATCH_H_
+#define _BEZIER_BATCH_H_
+
+#include "bezier_curve.h"
+#include <vector>
+
+/*
+The class calculating the curve points of many Bezier curves at once. Curves are grouped by their number of control points,
+and the control points of every group are stacked as the columns of a single matrix. Then the curve points of the whole group
+are the product of the shared Bernstein basis matrix and that matrix.
+*/
+class BezierBatch
+{
+
+public:
+
+	// The stacked coordinates of the control points of the current group (the X and then the Y coordinates of every curve)
+	std::vector<double> _coordinates;
+
+	// The arrays where the curve points of the current group are stored (the X and then the Y array of every curve)
+	std::vector<double *> _outputs;
+
+	/*
+	Constructor of the class
+	*/
+	BezierBatch();
+
+	/*
+	Destructor of the class
+	*/
+	~BezierBatch();
+
+	/*
+	Raises the degree of the given curves so all of them have the degree of the highest one. Curves with the same degree share
+	the same cached elevation matrix.
+	NOTE: Curves with less than two control points are ignored.
+	@param std::vector<BezierCurve *> * curves The curves to be raised
+	@return int The common number of control points (0 if no curve has at least two control points)
+	*/
+	int RaiseToCommonDegree(std::vector<BezierCurve *> * curves);
+
+	/*
+	Calculates the curve points in the domain [x, y] of all of the given curves and stores them in the curve points of every
+	curve (_curveX and _curveY). Curves with less than two control points are ignored, and curves that are rational or not 
+	tessellated with DeCasteljau's algorithm are tessellated individually.
+	@param std::vector<BezierCurve *> * curves The curves to be tessellated
+	@param double x The left value of the parameter domain
+	@param double y The right value of the parameter domain
+	@param int segments The number of segments of the curves
+	*/
+	void Tessellate(std::vector<BezierCurve *> * curves, double x, double y, int segments);
+
+	/*
+	Calculates the curve points of a group of curves with the same number of control points.
+	@param std::vector<BezierCurve *> & group The curves of the group
+	@param int nPoints The number of control points of every curve in the group
+	@param double x The left value of the parameter domain
+	@param double y The right value of the parameter domain
+	@param int segments The number of segments of the curves
+	*/
+	void TessellateGroup(std::vector<BezierCurve *> & group, int nPoints, double x, double y, int segments);
+
+};
+
+#endif
@@ -1,277 +1,2757 @@
 #include "bezier_curve.h"
+#include "bounded_cache.h"
+#include "fixed_bezier.h"
+#include "simd.h"
 #include "utils.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <tuple>
+
+/*
+The matrices mapping the control points of a curve into its forward differences at the seed points of a tessellation.
+They only depend on the number of control points, the domain, the number of segments and the reseed interval, so they are 
+shared by every curve tessellated with the same values.
+*/
+struct ForwardDifferenceSeeds
+{
+	// The indices of the curve points where the differences are seeded
+	std::vector<int> _indices;
+
+	// The seed matrices, one after the other. Row m of a matrix holds the weights of the control points for the m-th difference
+	std::vector<double> _matrices;
+};
+
+// The key of the forward difference seeds (number of control points, left domain, right domain, segments, reseed interval)
+typedef std::tuple<int, double, double, int, int> ForwardDifferenceKey;
+
+/*
+Returns the forward difference seeds for the given values. Seeds are built the first time they are requested and cached.
+@param int nPoints The number of control points
+@param double x The left value of the parameter domain
+@param double y The right value of the parameter domain
+@param int segments The number of segments of the curve
+@param int reseedInterval The number of steps between two seeds
+@return std::shared_ptr<const ForwardDifferenceSeeds> The pointer to the seeds
+*/
+static std::shared_ptr<const ForwardDifferenceSeeds> GetForwardDifferenceSeeds(int nPoints, double x, double y, int segments, int reseedInterval)
+{
+	// The cached seeds
+	static BoundedCache<ForwardDifferenceKey, ForwardDifferenceSeeds> cache;
+
+	// Return the cached seeds if they exist
+	ForwardDifferenceKey key(nPoints, x, y, segments, reseedInterval);
+	std::shared_ptr<const ForwardDifferenceSeeds> cached = cache.Find(key);
+	if (cached) 
+	{
+		return cached;
+	}
+
+	// Initialize the new seeds
+	std::shared_ptr<ForwardDifferenceSeeds> seeds(new ForwardDifferenceSeeds());
+
+	// Define the indices of the seeds, the last curve point is always seeded so it is exact
+	for (int j = 0; j < segments; j += reseedInterval) 
+	{
+		seeds->_indices.push_back(j);
+	}
+	seeds->_indices.push_back(segments);
+
+	// Get the number of seeds and the size of every matrix
+	int nSeeds = seeds->_indices.size();
+	int matrixSize = nPoints * nPoints;
+	seeds->_matrices.resize(nSeeds * matrixSize);
+
+	// The parameter step and the Bernstein values of every control point
+	double tStep = (y - x) / (double)segments;
+	std::vector<double> basis(nPoints);
+
+	// Build the matrix of every seed
+	for (int s = 0; s < nSeeds; s += 1) 
+	{
+		double * matrix = &seeds->_matrices[s * matrixSize];
+
+		// Store the Bernstein values at the seed point and the following nPoints - 1 points
+		for (int m = 0; m < nPoints; m += 1) 
+		{
+			// The parameter of the current point (the curve end is used as is, so it is exact)
+			int j = seeds->_indices.at(s) + m;
+			double t = (j == segments) ? y : x + (j * tStep);
+
+			// Calculate the Bernstein values at t using the DeCasteljau recurrence
+			double _t = 1.0 - t;
+			basis[0] = 1.0;
+			for (int k = 1; k < nPoints; k += 1) 
+			{
+				basis[k] = t * basis[k - 1];
+				for (int i = k - 1; i > 0; i -= 1) 
+				{
+					basis[i] = (_t * basis[i]) + (t * basis[i - 1]);
+				}
+				basis[0] = _t * basis[0];
+			}
+
+			// Store the values as row m
+			for (int i = 0; i < nPoints; i += 1) 
+			{
+				matrix[(m * nPoints) + i] = basis[i];
+			}
+		}
+
+		// Turn the rows of values into rows of forward differences
+		for (int level = 1; level < nPoints; level += 1) 
+		{
+			for (int m = nPoints - 1; m >= level; m -= 1) 
+			{
+				for (int i = 0; i < nPoints; i += 1) 
+				{
+					matrix[(m * nPoints) + i] -= matrix[((m - 1) * nPoints) + i];
+				}
+			}
+		}
+	}
+
+	// Store the seeds and return the pointer to them
+	return cache.Insert(key, seeds);
+}
+
+// The key of the split matrices (number of control points, number of pieces)
+typedef std::pair<int, int> SplitKey;
+
+/*
+Returns the matrices mapping the control points of a curve into the control points of its pieces when it is split into equal
+parameter intervals. Matrices are built the first time they are requested and cached.
+NOTE: Row r of the matrix of piece p holds the weights of the control points for the blossom with n - 1 - r arguments equal to
+p / pieces and r arguments equal to (p + 1) / pieces (n is the number of control points).
+@param int nPoints The number of control points
+@param int pieces The number of pieces
+@return std::shared_ptr<const std::vector<double>> The pointer to the matrices (nPoints x nPoints each, one after the other)
+*/
+static std::shared_ptr<const std::vector<double>> GetSplitMatrices(int nPoints, int pieces)
+{
+	// The cached matrices
+	static BoundedCache<SplitKey, std::vector<double>> cache;
+
+	// Return the cached matrices if they exist
+	SplitKey key(nPoints, pieces);
+	std::shared_ptr<const std::vector<double>> cached = cache.Find(key);
+	if (cached) 
+	{
+		return cached;
+	}
+
+	// Initialize the new matrices
+	int matrixSize = nPoints * nPoints;
+	std::shared_ptr<std::vector<double>> matrices(new std::vector<double>(pieces * matrixSize));
+
+	// The weights of the control points for the current blossom
+	std::vector<double> weights(nPoints);
+
+	// Build the matrix of every piece
+	for (int p = 0; p < pieces; p += 1) 
+	{
+		double * matrix = matrices->data() + (p * matrixSize);
+
+		// Get the parameter domain of the piece
+		double a = (double)p / (double)pieces;
+		double b = (double)(p + 1) / (double)pieces;
+
+		// Calculate every row of the matrix
+		for (int r = 0; r < nPoints; r += 1) 
+		{
+			// Run the Bernstein recurrence using b in the first r levels and a in the remaining ones
+			weights[0] = 1.0;
+			for (int k = 1; k < nPoints; k += 1) 
+			{
+				double t = (k <= r) ? b : a;
+				double _t = 1.0 - t;
+				weights[k] = t * weights[k - 1];
+				for (int i = k - 1; i > 0; i -= 1) 
+				{
+					weights[i] = (_t * weights[i]) + (t * weights[i - 1]);
+				}
+				weights[0] = _t * weights[0];
+			}
+
+			// Store the weights as row r
+			for (int i = 0; i < nPoints; i += 1) 
+			{
+				matrix[(r * nPoints) + i] = weights[i];
+			}
+		}
+	}
+
+	// Store the matrices and return the pointer to them
+	return cache.Insert(key, matrices);
+}
+
+// The key of the elevation matrices (number of control points, number of degrees raised)
+typedef std::pair<int, int> ElevationKey;
+
+/*
+Returns the matrix mapping the control points of a curve into the control points of the same curve with its degree raised r times.
+The matrix is built the first time it is requested and cached.
+NOTE: For a curve of degree n, new control point j is the sum of C(n, i) C(r, j - i) / C(n + r, j) P_i for max(0, j - r) <= i <= min(n, j).
+@param int nPoints The number of control points
+@param int r The number of degrees raised
+@return std::shared_ptr<const std::vector<double>> The pointer to the matrix ((nPoints + r) x nPoints)
+*/
+static std::shared_ptr<const std::vector<double>> GetElevationMatrix(int nPoints, int r)
+{
+	// The cached matrices
+	static BoundedCache<ElevationKey, std::vector<double>> cache;
+
+	// Return the cached matrix if it exists
+	ElevationKey key(nPoints, r);
+	std::shared_ptr<const std::vector<double>> cached = cache.Find(key);
+	if (cached) 
+	{
+		return cached;
+	}
+
+	// Get the degree of the curve and the number of new control points
+	int n = nPoints - 1;
+	int nNewPoints = nPoints + r;
+
+	// Calculate the binomial coefficients C(n, i), C(r, k) and C(n + r, j)
+	std::vector<double> binomialN(n + 1);
+	std::vector<double> binomialR(r + 1);
+	std::vector<double> binomialNR(n + r + 1);
+	binomialN[0] = 1.0;
+	for (int i = 1; i <= n; i += 1) 
+	{
+		binomialN[i] = (binomialN[i - 1] * (double)(n - i + 1)) / (double)i;
+	}
+	binomialR[0] = 1.0;
+	for (int k = 1; k <= r; k += 1) 
+	{
+		binomialR[k] = (binomialR[k - 1] * (double)(r - k + 1)) / (double)k;
+	}
+	binomialNR[0] = 1.0;
+	for (int j = 1; j <= n + r; j += 1) 
+	{
+		binomialNR[j] = (binomialNR[j - 1] * (double)(n + r - j + 1)) / (double)j;
+	}
+
+	// Initialize the new matrix and fill its band
+	std::shared_ptr<std::vector<double>> matrix(new std::vector<double>(nNewPoints * nPoints, 0.0));
+	for (int j = 0; j < nNewPoints; j += 1) 
+	{
+		int first = (j - r > 0) ? j - r : 0;
+		int last = (j < n) ? j : n;
+		for (int i = first; i <= last; i += 1) 
+		{
+			(*matrix)[(j * nPoints) + i] = (binomialN[i] * binomialR[j - i]) / binomialNR[j];
+		}
+	}
+
+	// Store the matrix and return the pointer to it
+	return cache.Insert(key, matrix);
+}
+
+// The key of the reduction matrices (number of control points, number of reduced control points)
+typedef std::pair<int, int> ReductionKey;
+
+/*
+Returns the matrix mapping the control points of a curve into the control points of its degree reduction to m control points.
+The reduced curve keeps both end points and its inner control points are the least squares fit whose elevation back to the
+original degree is closest to the original control points. The matrix is built the first time it is requested and cached.
+@param int nPoints The number of control points
+@param int m The number of control points of the reduced curve (2 <= m < nPoints)
+@return std::shared_ptr<const std::vector<double>> The pointer to the matrix (m x nPoints)
+*/
+static std::shared_ptr<const std::vector<double>> GetReductionMatrix(int nPoints, int m)
+{
+	// The cached matrices
+	static BoundedCache<ReductionKey, std::vector<double>> cache;
+
+	// Return the cached matrix if it exists
+	ReductionKey key(nPoints, m);
+	std::shared_ptr<const std::vector<double>> cached = cache.Find(key);
+	if (cached) 
+	{
+		return cached;
+	}
+
+	// Get the matrix elevating the reduced curve back to the original degree (nPoints x m)
+	std::shared_ptr<const std::vector<double>> elevation = GetElevationMatrix(m, nPoints - m);
+	const double * e = elevation->data();
+
+	// Initialize the new matrix, the end points are kept as they are
+	std::shared_ptr<std::vector<double>> matrix(new std::vector<double>(m * nPoints, 0.0));
+	(*matrix)[0] = 1.0;
+	(*matrix)[((m - 1) * nPoints) + (nPoints - 1)] = 1.0;
+
+	// Get the number of inner control points, if there are none then the matrix is complete
+	int nInner = m - 2;
+	if (nInner > 0) 
+	{
+		// Calculate the normal matrix of the inner columns of the elevation matrix (nInner x nInner)
+		std::vector<double> normal(nInner * nInner);
+		for (int a = 0; a < nInner; a += 1) 
+		{
+			for (int b = 0; b < nInner; b += 1) 
+			{
+				double sum = 0.0;
+				for (int j = 0; j < nPoints; j += 1) 
+				{
+					sum += e[(j * m) + 1 + a] * e[(j * m) + 1 + b];
+				}
+				normal[(a * nInner) + b] = sum;
+			}
+		}
+
+		// Calculate the right hand sides, the transposed inner columns with the contribution of the fixed end points removed
+		std::vector<double> rhs(nInner * nPoints);
+		for (int a = 0; a < nInner; a += 1) 
+		{
+			double firstSum = 0.0;
+			double lastSum = 0.0;
+			for (int k = 0; k < nPoints; k += 1) 
+			{
+				double g = e[(k * m) + 1 + a];
+				rhs[(a * nPoints) + k] = g;
+				firstSum += g * e[k * m];
+				lastSum += g * e[(k * m) + (m - 1)];
+			}
+			rhs[a * nPoints] -= firstSum;
+			rhs[(a * nPoints) + (nPoints - 1)] -= lastSum;
+		}
+
+		// Factorize the normal matrix in place using Cholesky (it is symmetric and positive definite)
+		for (int a = 0; a < nInner; a += 1) 
+		{
+			for (int b = 0; b <= a; b += 1) 
+			{
+				double sum = normal[(a * nInner) + b];
+				for (int k = 0; k < b; k += 1) 
+				{
+					sum -= normal[(a * nInner) + k] * normal[(b * nInner) + k];
+				}
+				normal[(a * nInner) + b] = (a == b) ? std::sqrt(sum) : sum / normal[(b * nInner) + b];
+			}
+		}
+
+		// Solve the system for every column of the right hand sides and store the solutions as the inner rows
+		std::vector<double> solution(nInner);
+		for (int k = 0; k < nPoints; k += 1) 
+		{
+			// Forward substitution
+			for (int a = 0; a < nInner; a += 1) 
+			{
+				double sum = rhs[(a * nPoints) + k];
+				for (int b = 0; b < a; b += 1) 
+				{
+					sum -= normal[(a * nInner) + b] * solution[b];
+				}
+				solution[a] = sum / normal[(a * nInner) + a];
+			}
+
+			// Backward substitution
+			for (int a = nInner - 1; a >= 0; a -= 1) 
+			{
+				double sum = solution[a];
+				for (int b = a + 1; b < nInner; b += 1) 
+				{
+					sum -= normal[(b * nInner) + a] * solution[b];
+				}
+				solution[a] = sum / normal[(a * nInner) + a];
+			}
+
+			// Store the solution
+			for (int a = 0; a < nInner; a += 1) 
+			{
+				(*matrix)[((a + 1) * nPoints) + k] = solution[a];
+			}
+		}
+	}
+
+	// Store the matrix and return the pointer to it
+	return cache.Insert(key, matrix);
+}
+
+/*
+Loads the control points of a curve into a scratch buffer, multiplying the X, Y and Z coordinates of rational curves by their
+weights so they can be combined in homogeneous coordinates. The control points of the curve are left as they are.
+@param const ControlPoints * controlPoints The control points of the curve
+@param bool rational If the W coordinates of the control points are used as weights
+@param std::vector<double> & buffer The buffer where the X, Y, Z and W arrays are stored, one after the other (n values each)
+@return double * The pointer to the X array
+*/
+static double * LoadWeighted(const ControlPoints * controlPoints, bool rational, std::vector<double> & buffer)
+{
+	int n = controlPoints->size();
+	buffer.resize(4 * n);
+	double * x = buffer.data();
+	double * y = x + n;
+	double * z = y + n;
+	double * w = z + n;
+	for (int i = 0; i < n; i += 1) 
+	{
+		w[i] = controlPoints->_w[i];
+		x[i] = rational ? w[i] * controlPoints->_x[i] : controlPoints->_x[i];
+		y[i] = rational ? w[i] * controlPoints->_y[i] : controlPoints->_y[i];
+		z[i] = rational ? w[i] * controlPoints->_z[i] : controlPoints->_z[i];
+	}
+	return x;
+}
+
+/*
+Adds a control point to a set of control points, projecting it back from homogeneous coordinates if the curve is rational.
+@param ControlPoints * controlPoints The control points
+@param bool rational If the point is in homogeneous coordinates
+@param double x The X coordinate of the point
+@param double y The Y coordinate of the point
+@param double z The Z coordinate of the point
+@param double w The W coordinate of the point
+*/
+static void PushProjected(ControlPoints * controlPoints, bool rational, double x, double y, double z, double w)
+{
+	if (rational) 
+	{
+		controlPoints->push_back(x / w, y / w, z / w, w);
+	}
+	else 
+	{
+		controlPoints->push_back(x, y, z, w);
+	}
+}
+
+/*
+Stores the curve point, the unit tangent, the unit normal and the signed curvature (x' y'' - y' x'') / |P'|^3 of a parameter.
+NOTE: Where the first derivative vanishes the tangent, the normal and the curvature are zero.
+@param CurveFrames & frames The frames where the values are stored
+@param size_t k The index of the parameter
+@param double px The X coordinate of the curve point
+@param double py The Y coordinate of the curve point
+@param double x1 The X coordinate of the first derivative
+@param double y1 The Y coordinate of the first derivative
+@param double x2 The X coordinate of the second derivative
+@param double y2 The Y coordinate of the second derivative
+*/
+static void StoreFrame(CurveFrames & frames, size_t k, double px, double py, double x1, double y1, double x2, double y2)
+{
+	// Store the point
+	frames._x[k] = px;
+	frames._y[k] = py;
+
+	// Get the speed of the curve, if it is zero then the frame is not defined
+	double speed = std::sqrt((x1 * x1) + (y1 * y1));
+	if (speed == 0.0) 
+	{
+		frames._tangentX[k] = frames._tangentY[k] = 0.0;
+		frames._normalX[k] = frames._normalY[k] = 0.0;
+		frames._curvature[k] = 0.0;
+		return;
+	}
+
+	// Store the unit tangent, the unit normal and the signed curvature
+	frames._tangentX[k] = x1 / speed;
+	frames._tangentY[k] = y1 / speed;
+	frames._normalX[k] = -y1 / speed;
+	frames._normalY[k] = x1 / speed;
+	frames._curvature[k] = ((x1 * y2) - (y1 * x2)) / (speed * speed * speed);
+}
+
+/*
+Calculates the frames of a polynomial curve with N control points at many parameters using its fixed degree kernel. The
+first and the second derivatives are fixed degree curves built once, so every parameter evaluates three small curves.
+@param const ControlPoints * controlPoints The control points of the curve
+@param const double * t The array with the parameters
+@param size_t n The number of parameters
+@param CurveFrames & frames The frames where the values are stored (every array already holds n values)
+*/
+template<int N>
+static void EvaluateFramesFixed(const ControlPoints * controlPoints, const double * t, size_t n, CurveFrames & frames)
+{
+	FixedBezier<N, 2, double> curve;
+	const ControlScalar * coordinates[2] = { controlPoints->_x, controlPoints->_y };
+	curve.Load(coordinates);
+
+	// Get the derivatives (the second derivative of a line is zero)
+	FixedBezier<N - 1, 2, double> first = curve.Derivative();
+	typename FixedDerivative<N - 1, 2, double>::Type second = FixedDerivative<N - 1, 2, double>::Of(first);
+
+	for (size_t k = 0; k < n; k += 1) 
+	{
+		double point[2];
+		double d1[2];
+		double d2[2];
+		curve.Evaluate(t[k], point);
+		first.Evaluate(t[k], d1);
+		second.Evaluate(t[k], d2);
+		StoreFrame(frames, k, point[0], point[1], d1[0], d1[1], d2[0], d2[1]);
+	}
+}
+
+/*
+Evaluates a curve with N control points at parameter t using its fixed degree kernel.
+@param const ControlPoints * controlPoints The control points of the curve
+@param double t The parameter for the point
+@return Point The point at the given parameter
+*/
+template<int N>
+static Point EvaluateFixed(const ControlPoints * controlPoints, double t)
+{
+	FixedBezier<N, 2, double> curve;
+	const ControlScalar * coordinates[2] = { controlPoints->_x, controlPoints->_y };
+	curve.Load(coordinates);
+
+	double point[2];
+	curve.Evaluate(t, point);
+	return Point(point[0], point[1]);
+}
+
+/*
+Evaluates a curve with N control points at many parameters using its fixed degree kernel.
+@param const ControlPoints * controlPoints The control points of the curve
+@param const double * t The array with the parameters
+@param size_t n The number of parameters
+@param double * outX The array where the X coordinates are stored (n values)
+@param double * outY The array where the Y coordinates are stored (n values)
+*/
+template<int N>
+static void EvaluateManyFixed(const ControlPoints * controlPoints, const double * t, size_t n, double * outX, double * outY)
+{
+	FixedBezier<N, 2, double> curve;
+	const ControlScalar * coordinates[2] = { controlPoints->_x, controlPoints->_y };
+	curve.Load(coordinates);
+
+	double * out[2] = { outX, outY };
+	curve.EvaluateMany(t, n, out);
+}
+
+/*
+Subdivides a curve with N control points at parameter t using its fixed degree kernel.
+NOTE: The second half is stored from the last control point to the point at t, as BezierCurve::Subdivide does.
+@param const ControlPoints * controlPoints The control points of the curve
+@param double t The cutting parameter
+@param ControlPoints * firstHalf The control points where the first half is stored
+@param ControlPoints * secondHalf The control points where the second half is stored
+*/
+template<int N>
+static void SubdivideFixed(const ControlPoints * controlPoints, double t, ControlPoints * firstHalf, ControlPoints * secondHalf)
+{
+	// Load every coordinate (X, Y, Z and W), so the halves keep everything the generic path keeps
+	FixedBezier<N, 4, double> curve;
+	const ControlScalar * coordinates[4] = { controlPoints->_x, controlPoints->_y, controlPoints->_z, controlPoints->_w };
+	curve.Load(coordinates);
+
+	FixedBezier<N, 4, double> left;
+	FixedBezier<N, 4, double> right;
+	curve.Subdivide(t, left, right);
+
+	for (int i = 0; i < N; i += 1) 
+	{
+		const double * l = left._points[i];
+		const double * r = right._points[N - 1 - i];
+		firstHalf->push_back(l[0], l[1], l[2], l[3]);
+		secondHalf->push_back(r[0], r[1], r[2], r[3]);
+	}
+}
+
+/*
+Adds the control points of a fixed degree hodograph to a set of control points. Hodographs of polynomial curves have W 0, as
+the ones calculated by BezierCurve::Hodograph.
+@param const FixedBezier<N, 3, double> & hodograph The hodograph (X, Y and Z coordinates)
+@param ControlPoints * controlPoints The control points where the hodograph is stored
+*/
+template<int N>
+static void StoreFixedHodograph(const FixedBezier<N, 3, double> & hodograph, ControlPoints * controlPoints)
+{
+	for (int i = 0; i < N; i += 1) 
+	{
+		const double * p = hodograph._points[i];
+		controlPoints->push_back(p[0], p[1], p[2], 0.0);
+	}
+}
+
+/*
+Calculates the first and the second hodographs of a polynomial curve with N control points using its fixed degree kernel.
+@param const ControlPoints * controlPoints The control points of the curve
+@param ControlPoints * first The control points where the first hodograph is stored (N - 1 control points)
+@param ControlPoints * second The control points where the second hodograph is stored (N - 2 control points)
+*/
+template<int N>
+static void HodographsFixed(const ControlPoints * controlPoints, ControlPoints * first, ControlPoints * second)
+{
+	FixedBezier<N, 3, double> curve;
+	const ControlScalar * coordinates[3] = { controlPoints->_x, controlPoints->_y, controlPoints->_z };
+	curve.Load(coordinates);
+
+	// A line has no second hodograph
+	FixedBezier<N - 1, 3, double> firstHodograph = curve.Derivative();
+	StoreFixedHodograph(firstHodograph, first);
+	if (N > 2) 
+	{
+		StoreFixedHodograph(FixedDerivative<N - 1, 3, double>::Of(firstHodograph), second);
+	}
+}
+
+/*
+Calculates the first and the second hodographs of a curve with any number of control points. The hodographs of rational
+curves are the ones of their weighted control points (see BezierCurve::Hodograph).
+@param const ControlPoints * controlPoints The control points of the curve
+@param bool rational If the W coordinates of the control points are used as weights
+@param ControlPoints * first The control points where the first hodograph is stored
+@param ControlPoints * second The control points where the second hodograph is stored
+*/
+static void HodographsGeneric(const ControlPoints * controlPoints, bool rational, ControlPoints * first, ControlPoints * second)
+{
+	// Get the number of control points
+	int nPoints = controlPoints->size();
+
+	// Calculate the first hodograph from the (weighted) control points
+	first->reserve(nPoints);
+	for (int i = 0; i + 1 < nPoints; i += 1) 
+	{
+		double w0 = rational ? controlPoints->_w[i] : 1.0;
+		double w1 = rational ? controlPoints->_w[i + 1] : 1.0;
+		double scale = (double)(nPoints - 1);
+		first->push_back(
+			scale * ((w1 * controlPoints->_x[i + 1]) - (w0 * controlPoints->_x[i])), 
+			scale * ((w1 * controlPoints->_y[i + 1]) - (w0 * controlPoints->_y[i])), 
+			scale * ((w1 * controlPoints->_z[i + 1]) - (w0 * controlPoints->_z[i])), 
+			scale * (w1 - w0));
+	}
+
+	// Calculate the second hodograph from the first one
+	int nFirst = first->size();
+	second->reserve(nFirst);
+	for (int i = 0; i + 1 < nFirst; i += 1) 
+	{
+		double scale = (double)(nFirst - 1);
+		second->push_back(
+			scale * (first->_x[i + 1] - first->_x[i]), 
+			scale * (first->_y[i + 1] - first->_y[i]), 
+			scale * (first->_z[i + 1] - first->_z[i]), 
+			scale * (first->_w[i + 1] - first->_w[i]));
+	}
+}
+
+/*
+Subdivides a curve at parameter t running the DeCasteljau triangle over any number of control points.
+NOTE: The second half is stored from the last control point to the point at t.
+@param const ControlPoints * controlPoints The control points of the curve
+@param bool rational If the curve is subdivided in homogeneous coordinates
+@param double t The cutting parameter
+@param ControlPoints * firstHalf The control points where the first half is stored
+@param ControlPoints * secondHalf The control points where the second half is stored
+*/
+static void SubdivideGeneric(const ControlPoints * controlPoints, bool rational, double t, ControlPoints * firstHalf, ControlPoints * secondHalf)
+{
+	// Get the number of control points
+	int nPoints = controlPoints->size();
+
+	// Load the control points into the scratch buffer, the DeCasteljau triangle runs in place over it
+	static thread_local std::vector<double> scratchBuffer;
+	double * x = LoadWeighted(controlPoints, rational, scratchBuffer);
+	double * y = x + nPoints;
+	double * z = y + nPoints;
+	double * w = z + nPoints;
+
+	// Insert a copy of the first control point into the first half points
+	PushProjected(firstHalf, rational, x[0], y[0], z[0], w[0]);
+
+	// Insert a copy of the last control point into the second half points
+	PushProjected(secondHalf, rational, x[nPoints - 1], y[nPoints - 1], z[nPoints - 1], w[nPoints - 1]);
+
+	// Calculate 1 - t
+	double _t = 1.0 - t;
+
+	// Repeat while there is more than one point in the current DeCasteljau level
+	for (int n = nPoints - 1; n > 0; n -= 1)
+	{
+		// Find the linear interpolation between the current DeCasteljau points and the next ones
+		for (int i = 0; i < n; i += 1)
+		{
+			x[i] = (_t * x[i]) + (t * x[i + 1]);
+			y[i] = (_t * y[i]) + (t * y[i + 1]);
+			z[i] = (_t * z[i]) + (t * z[i + 1]);
+			w[i] = (_t * w[i]) + (t * w[i + 1]);
+		}
+
+		// Push a copy of the first point of the level to the first half
+		PushProjected(firstHalf, rational, x[0], y[0], z[0], w[0]);
+
+		// Push a copy of the last point of the level to the second half
+		PushProjected(secondHalf, rational, x[n - 1], y[n - 1], z[n - 1], w[n - 1]);
+	}
+}
+
+/*
+Calculates the homogeneous control points of the part of a curve in the domain [a, b]. Control point i is the blossom of the 
+curve with n - 1 - i arguments equal to a and i arguments equal to b (n is the number of control points).
+NOTE: The control points of polynomial curves have weight 1.
+@param const ControlPoints * controlPoints The control points of the curve
+@param bool rational If the W coordinates of the control points are used as weights
+@param double a The left value of the parameter domain
+@param double b The right value of the parameter domain
+@param double * outX The array where the weighted X coordinates are stored (n values)
+@param double * outY The array where the weighted Y coordinates are stored (n values)
+@param double * outW The array where the weights are stored (n values)
+*/
+static void DomainControlPoints(const ControlPoints * controlPoints, bool rational, double a, double b, double * outX, double * outY, double * outW)
+{
+	// Get the number of control points
+	int nPoints = controlPoints->size();
+
+	// The scratch buffer where the blossoms are evaluated
+	static thread_local std::vector<double> scratchBuffer;
+	if ((int)scratchBuffer.size() < 3 * nPoints) 
+	{
+		scratchBuffer.resize(3 * nPoints);
+	}
+	double * x = scratchBuffer.data();
+	double * y = scratchBuffer.data() + nPoints;
+	double * w = scratchBuffer.data() + (2 * nPoints);
+
+	// Traverse through the control points of the part
+	for (int i = 0; i < nPoints; i += 1) 
+	{
+		// Load the homogeneous coordinates of the control points
+		for (int j = 0; j < nPoints; j += 1) 
+		{
+			w[j] = rational ? controlPoints->_w[j] : 1.0;
+			x[j] = w[j] * controlPoints->_x[j];
+			y[j] = w[j] * controlPoints->_y[j];
+		}
+
+		// Run the DeCasteljau triangle using b in the first i levels and a in the remaining ones
+		for (int n = nPoints - 1; n > 0; n -= 1) 
+		{
+			double t = (nPoints - n <= i) ? b : a;
+			double _t = 1.0 - t;
+			for (int j = 0; j < n; j += 1) 
+			{
+				x[j] = (_t * x[j]) + (t * x[j + 1]);
+				y[j] = (_t * y[j]) + (t * y[j + 1]);
+				w[j] = (_t * w[j]) + (t * w[j + 1]);
+			}
+		}
+
+		// The first value holds the control point
+		outX[i] = x[0];
+		outY[i] = y[0];
+		outW[i] = w[0];
+	}
+}
+
+/*
+Indicates whether every control point of a polygon is within the given distance from the segment between its first and last points.
+@param const double * x The weighted X coordinates of the control points
+@param const double * y The weighted Y coordinates of the control points
+@param const double * w The weights of the control points
+@param int nPoints The number of control points
+@param double tolerance2 The squared distance
+@return bool If the polygon is flat
+*/
+static bool IsFlat(const double * x, const double * y, const double * w, int nPoints, double tolerance2)
+{
+	// Get the first and last points of the polygon
+	double x0 = x[0] / w[0];
+	double y0 = y[0] / w[0];
+	double x1 = x[nPoints - 1] / w[nPoints - 1];
+	double y1 = y[nPoints - 1] / w[nPoints - 1];
+
+	// Get the vector of the segment and its squared length
+	double dx = x1 - x0;
+	double dy = y1 - y0;
+	double length2 = (dx * dx) + (dy * dy);
+
+	// Traverse through the inner control points
+	for (int i = 1; i < nPoints - 1; i += 1) 
+	{
+		// Get the current control point
+		double xi = x[i] / w[i];
+		double yi = y[i] / w[i];
+
+		// Find the closest point of the segment
+		// NOTE: The segment is used instead of its line, otherwise a curve folding back over its chord would look flat
+		double u = 0.0;
+		if (length2 > 0.0) 
+		{
+			u = (((xi - x0) * dx) + ((yi - y0) * dy)) / length2;
+			u = (u < 0.0) ? 0.0 : ((u > 1.0) ? 1.0 : u);
+		}
+
+		// Get the squared distance to the closest point
+		double ex = xi - (x0 + (u * dx));
+		double ey = yi - (y0 + (u * dy));
+		if ((ex * ex) + (ey * ey) > tolerance2) 
+		{
+			return false;
+		}
+	}
+
+	// Every control point is close enough
+	return true;
+}
+
+/*
+Projects points back from homogeneous coordinates, this is, divides their coordinates by their weights.
+@param double * x The weighted X coordinates of the points
+@param double * y The weighted Y coordinates of the points
+@param const double * w The weights of the points
+@param int n The number of points
+*/
+static void ProjectHomogeneous(double * x, double * y, const double * w, int n)
+{
+	for (int i = 0; i < n; i += 1) 
+	{
+		x[i] /= w[i];
+		y[i] /= w[i];
+	}
+}
+
+/*
+Projects a vector of points back from homogeneous coordinates, this is, divides their coordinates by their W coordinate.
+@param std::vector<Point *> * points The points
+*/
+static void ProjectPointVector(std::vector<Point *> * points)
+{
+	int nPoints = points->size();
+	for (int i = 0; i < nPoints; i += 1) 
+	{
+		Point * p = points->at(i);
+		p->set(p->x / p->w, p->y / p->w, p->z / p->w, p->w);
+	}
+}
+
+// The nodes and weights of the 5 point Gauss-Legendre quadrature in [-1, 1]
+static const double GAUSS_LEGENDRE_NODES[5] = { -0.9061798459386640, -0.5384693101056831, 0.0, 0.5384693101056831, 0.9061798459386640 };
+static const double GAUSS_LEGENDRE_WEIGHTS[5] = { 0.2369268850561891, 0.4786286704993665, 0.5688888888888889, 0.4786286704993665, 0.2369268850561891 };
+
+/*
+Evaluates a set of control points at parameter t using DeCasteljau's algorithm over their X, Y and W coordinates.
+@param const ControlPoints * points The control points
+@param bool weighted If the X and Y coordinates are multiplied by W before running the algorithm (the control points of a 
+rational curve), otherwise they are used as they are (e.g. a hodograph)
+@param double t The parameter
+@param double & x The X coordinate of the result
+@param double & y The Y coordinate of the result
+@param double & w The W coordinate of the result
+*/
+static void EvaluateHomogeneous(const ControlPoints * points, bool weighted, double t, double & x, double & y, double & w)
+{
+	// Get the number of control points
+	int nPoints = points->size();
+
+	// The stack storage for the DeCasteljau values of typical degree curves
+	double stackBuffer[3 * BEZIER_STACK_POINTS];
+
+	// The scratch buffer for curves with more control points than the stack storage supports
+	static thread_local std::vector<double> scratchBuffer;
+
+	// Point to the stack storage, or to the scratch buffer if the curve does not fit in it
+	double * buffer = stackBuffer;
+	if (nPoints > BEZIER_STACK_POINTS) 
+	{
+		if ((int)scratchBuffer.size() < 3 * nPoints) 
+		{
+			scratchBuffer.resize(3 * nPoints);
+		}
+
+		buffer = scratchBuffer.data();
+	}
+
+	// Split the buffer and load the coordinates
+	double * bx = buffer;
+	double * by = buffer + nPoints;
+	double * bw = buffer + (2 * nPoints);
+	for (int i = 0; i < nPoints; i += 1) 
+	{
+		bw[i] = points->_w[i];
+		bx[i] = weighted ? bw[i] * points->_x[i] : points->_x[i];
+		by[i] = weighted ? bw[i] * points->_y[i] : points->_y[i];
+	}
+
+	// Run the DeCasteljau triangle in place
+	double _t = 1.0 - t;
+	for (int m = nPoints - 1; m > 0; m -= 1) 
+	{
+		for (int i = 0; i < m; i += 1) 
+		{
+			bx[i] = (_t * bx[i]) + (t * bx[i + 1]);
+			by[i] = (_t * by[i]) + (t * by[i + 1]);
+			bw[i] = (_t * bw[i]) + (t * bw[i + 1]);
+		}
+	}
+
+	// The first values hold the result
+	x = bx[0];
+	y = by[0];
+	w = bw[0];
+}
+
+/*
+Returns the speed of a curve at parameter t, this is, the length of its first derivative.
+@param const ControlPoints * controlPoints The control points of the curve
+@param const ControlPoints * hodograph The first hodograph of the curve (see BezierCurve::Hodograph)
+@param bool rational If the curve is rational
+@param double t The parameter
+@return double The speed of the curve at t
+*/
+static double Speed(const ControlPoints * controlPoints, const ControlPoints * hodograph, bool rational, double t)
+{
+	// A curve with a single control point does not move
+	if (hodograph->size() == 0) 
+	{
+		return 0.0;
+	}
+
+	// Evaluate the first derivative (in homogeneous coordinates for rational curves)
+	double dx, dy, dw;
+	EvaluateHomogeneous(hodograph, false, t, dx, dy, dw);
+	if (!rational) 
+	{
+		return std::sqrt((dx * dx) + (dy * dy));
+	}
+
+	// Apply the quotient rule, P' = (X' W - X W') / W^2
+	double x, y, w;
+	EvaluateHomogeneous(controlPoints, true, t, x, y, w);
+	double ex = (dx * w) - (x * dw);
+	double ey = (dy * w) - (y * dw);
+	return std::sqrt((ex * ex) + (ey * ey)) / (w * w);
+}
+
+/*
+Returns the arc length of a curve in the parameter interval [a, b] integrating its speed using Gauss-Legendre quadrature.
+@param const ControlPoints * controlPoints The control points of the curve
+@param const ControlPoints * hodograph The first hodograph of the curve
+@param bool rational If the curve is rational
+@param double a The left value of the interval
+@param double b The right value of the interval
+@return double The arc length of the interval
+*/
+static double IntegrateSpeed(const ControlPoints * controlPoints, const ControlPoints * hodograph, bool rational, double a, double b)
+{
+	// Map the nodes from [-1, 1] into [a, b] and add the weighted speeds
+	double half = 0.5 * (b - a);
+	double middle = 0.5 * (a + b);
+	double length = 0.0;
+	for (int i = 0; i < 5; i += 1) 
+	{
+		length += GAUSS_LEGENDRE_WEIGHTS[i] * Speed(controlPoints, hodograph, rational, middle + (half * GAUSS_LEGENDRE_NODES[i]));
+	}
+	return half * length;
+}
+
+/*
+Adds the product of two polynomials in Bernstein form to a third one. The product of degrees p and r has degree p + r and 
+coefficients c_k = sum over i + j = k of C(p, i) C(r, j) / C(p + r, k) a_i b_j.
+@param const double * a The coefficients of the first polynomial (p + 1 values)
+@param int p The degree of the first polynomial
+@param const double * b The coefficients of the second polynomial (r + 1 values)
+@param int r The degree of the second polynomial
+@param double scale The factor applied to the product before adding it
+@param double * out The coefficients where the product is added (p + r + 1 values)
+*/
+static void AddBernsteinProduct(const double * a, int p, const double * b, int r, double scale, double * out)
+{
+	// The stack storage for the binomial coefficients of typical degree curves
+	double stackBuffer[6 * BEZIER_STACK_POINTS];
+
+	// The scratch buffer for curves with more control points than the stack storage supports
+	static thread_local std::vector<double> scratchBuffer;
+
+	// Point to the stack storage, or to the scratch buffer if the binomials do not fit in it
+	int nValues = (p + 1) + (r + 1) + (p + r + 1);
+	double * buffer = stackBuffer;
+	if (nValues > 6 * BEZIER_STACK_POINTS) 
+	{
+		if ((int)scratchBuffer.size() < nValues) 
+		{
+			scratchBuffer.resize(nValues);
+		}
+
+		buffer = scratchBuffer.data();
+	}
+
+	// Calculate the binomial coefficients C(p, i), C(r, j) and C(p + r, k)
+	double * binomialP = buffer;
+	double * binomialR = buffer + (p + 1);
+	double * binomialPR = binomialR + (r + 1);
+	binomialP[0] = 1.0;
+	for (int i = 1; i <= p; i += 1) 
+	{
+		binomialP[i] = (binomialP[i - 1] * (double)(p - i + 1)) / (double)i;
+	}
+	binomialR[0] = 1.0;
+	for (int j = 1; j <= r; j += 1) 
+	{
+		binomialR[j] = (binomialR[j - 1] * (double)(r - j + 1)) / (double)j;
+	}
+	binomialPR[0] = 1.0;
+	for (int k = 1; k <= p + r; k += 1) 
+	{
+		binomialPR[k] = (binomialPR[k - 1] * (double)(p + r - k + 1)) / (double)k;
+	}
+
+	// Add every pair of coefficients to the coefficient of the sum of their indices
+	for (int i = 0; i <= p; i += 1) 
+	{
+		double ai = scale * binomialP[i] * a[i];
+		for (int j = 0; j <= r; j += 1) 
+		{
+			out[i + j] += (ai * binomialR[j] * b[j]) / binomialPR[i + j];
+		}
+	}
+}
+
+BezierCurve::BezierCurve() : 
+	_controlPoints(new ControlPoints()), 
+	_degrees(new std::vector<ControlPoints *>()), 
+	_drawableCurveLines(new DrawableLines()), 
+	_drawablePolygonLines(new DrawableLines()), 
+	_drawableDeCasteljauLines(new DrawableLines()), 
+	_drawableControlPoints(new DrawablePoints()), 
+	_drawableDeCasteljauPoints(new DrawablePoints()), 
+	_drawableCurveTPoint(new DrawablePoints()), 
+	_drawableCurveSPoint(new DrawablePoints()),
+	_drawableCurveTicks(new DrawablePoints()), 
+	_drawableConvexHull(new DrawablePolygon()), 
+	_deCasteljauT(-1.0f), 
+	_lastX(-1.0), 
+	_lastY(-1.0), 
+	_lastS(-1.0), 
+	_lastSLeft(-1.0), 
+	_lastSRight(-1.0), 
+	_arcLengthTicks(false), 
+	_tessellationMode(TESSELLATION_DECASTELJAU), 
+	_reseedInterval(FORWARD_DIFFERENCES_RESEED), 
+	_flatnessTolerance(ADAPTIVE_FLATNESS_TOLERANCE), 
+	_version(0), 
+	_curveVersion(-1), 
+	_rational(false), 
+	_firstHodograph(new ControlPoints()), 
+	_secondHodograph(new ControlPoints()), 
+	_hodographVersion(-1), 
+	_arcLengthVersion(-1), 
+	_projectionVersion(-1), 
+	_boundingBoxVersion(-1), 
+	_controlPointGrid(NULL), 
+	_controlPointGridVersion(-1), 
+	_convexHull(NULL), 
+	_convexHullVersion(-1)
+{
+}
+
+BezierCurve::~BezierCurve()
+{
+	// Delete the control points, the hodographs, the control point grid and the convex hull
+	delete _controlPoints;
+	delete _firstHodograph;
+	delete _secondHodograph;
+	delete _controlPointGrid;
+	delete _convexHull;
+
+	// Delete the drawable elements (releasing their shared shader programs)
+	delete _drawableCurveLines;
+	delete _drawablePolygonLines;
+	delete _drawableDeCasteljauLines;
+	delete _drawableDeCasteljauPoints;
+	delete _drawableControlPoints;
+	delete _drawableCurveTPoint;
+	delete _drawableCurveSPoint;
+	delete _drawableCurveTicks;
+	delete _drawableConvexHull;
+
+	// Get the number of degrees stored
+	int nDegrees = _degrees->size();
+
+	// Traverse through the degrees and delete them
+	for (int i = 0; i < nDegrees; i += 1) 
+	{
+		delete _degrees->at(i);
+	}
+
+	// Delete the degrees vector
+	delete _degrees;
+}
+
+void BezierCurve::AdaptiveTessellation(double x, double y, double tolerance, std::vector<double> & outX, std::vector<double> & outY)
+{
+	// Remove the previous points (the vectors keep their capacity)
+	outX.clear();
+	outY.clear();
+
+	// Get the number of control points
+	int nPoints = _controlPoints->size();
+
+	// If there are less than two control points then exit the function
+	if (nPoints < 2) 
+	{
+		return;
+	}
+
+	// The stack of control polygons to be tessellated, along with the number of splits of each one
+	// NOTE: The left half is always processed first, so the stack never holds more than ADAPTIVE_MAX_DEPTH + 1 polygons
+	// NOTE: Polygons are stored in homogeneous coordinates, so rational curves are split the same way (polynomial ones have weight 1)
+	static thread_local std::vector<double> stackX;
+	static thread_local std::vector<double> stackY;
+	static thread_local std::vector<double> stackW;
+	static thread_local std::vector<int> stackDepth;
+	if ((int)stackX.size() < (ADAPTIVE_MAX_DEPTH + 1) * nPoints) 
+	{
+		stackX.resize((ADAPTIVE_MAX_DEPTH + 1) * nPoints);
+		stackY.resize((ADAPTIVE_MAX_DEPTH + 1) * nPoints);
+		stackW.resize((ADAPTIVE_MAX_DEPTH + 1) * nPoints);
+	}
+	stackDepth.resize(ADAPTIVE_MAX_DEPTH + 1);
+
+	// Push the control points of the curve in the domain [x, y]
+	DomainControlPoints(_controlPoints, _rational, x, y, stackX.data(), stackY.data(), stackW.data());
+	stackDepth[0] = 0;
+	int top = 0;
+
+	// Store the first curve point
+	outX.push_back(stackX[0] / stackW[0]);
+	outY.push_back(stackY[0] / stackW[0]);
+
+	// Calculate the squared tolerance
+	double tolerance2 = tolerance * tolerance;
+
+	// Repeat while there are polygons in the stack
+	while (top >= 0) 
+	{
+		// Get the polygon on top of the stack
+		double * px = stackX.data() + (top * nPoints);
+		double * py = stackY.data() + (top * nPoints);
+		double * pw = stackW.data() + (top * nPoints);
+		int depth = stackDepth[top];
+
+		// If the polygon is flat (or cannot be split anymore) then store its last point and pop it
+		if (depth >= ADAPTIVE_MAX_DEPTH || IsFlat(px, py, pw, nPoints, tolerance2)) 
+		{
+			outX.push_back(px[nPoints - 1] / pw[nPoints - 1]);
+			outY.push_back(py[nPoints - 1] / pw[nPoints - 1]);
+			top -= 1;
+			continue;
+		}
+
+		// Get the slot above the polygon, the left half is stored there
+		double * lx = px + nPoints;
+		double * ly = py + nPoints;
+		double * lw = pw + nPoints;
+		lx[0] = px[0];
+		ly[0] = py[0];
+		lw[0] = pw[0];
+
+		// Run the DeCasteljau triangle at t = 0.5 in place, the polygon ends up holding the right half
+		for (int n = nPoints - 1; n > 0; n -= 1) 
+		{
+			for (int i = 0; i < n; i += 1) 
+			{
+				px[i] = 0.5 * (px[i] + px[i + 1]);
+				py[i] = 0.5 * (py[i] + py[i + 1]);
+				pw[i] = 0.5 * (pw[i] + pw[i + 1]);
+			}
+
+			// The first value of every level is a control point of the left half
+			lx[nPoints - n] = px[0];
+			ly[nPoints - n] = py[0];
+			lw[nPoints - n] = pw[0];
+		}
+
+		// Push the left half
+		stackDepth[top] = depth + 1;
+		stackDepth[top + 1] = depth + 1;
+		top += 1;
+	}
+}
+
+void BezierCurve::AddControlPoint(double x, double y)
+{
+	// Check if the grid and the convex hull match the control points before adding the point
+	bool gridUpToDate = _controlPointGrid && _controlPointGridVersion == _version;
+	bool hullUpToDate = _convexHull && _convexHullVersion == _version;
+
+	// Add the new point to the control points vector and indicate the geometries has been updated
+	_controlPoints->push_back(x, y);
+	_version += 1;
+
+	// Add the stored point to the grid
+	if (gridUpToDate) 
+	{
+		int index = _controlPoints->size() - 1;
+		_controlPointGrid->push_back(_controlPoints->_x[index], _controlPoints->_y[index]);
+		_controlPointGridVersion = _version;
+	}
+
+	// Add the stored point to the convex hull
+	if (hullUpToDate && _convexHull->push_back(_controlPoints)) 
+	{
+		_convexHullVersion = _version;
+	}
+}
+
+void BezierCurve::ArcLengthTable()
+{
+	// If the table matches the control points then exit the function
+	if (_arcLengthVersion == _version && (int)_arcLengths.size() == ARC_LENGTH_INTERVALS + 1) 
+	{
+		return;
+	}
+
+	// Get the first hodograph of the curve
+	const ControlPoints * hodograph = Hodograph(1);
+
+	// Add the length of every interval to the length of the previous ones
+	_arcLengths.resize(ARC_LENGTH_INTERVALS + 1);
+	_arcLengths[0] = 0.0;
+	for (int i = 0; i < ARC_LENGTH_INTERVALS; i += 1) 
+	{
+		double a = (double)i / (double)ARC_LENGTH_INTERVALS;
+		double b = (double)(i + 1) / (double)ARC_LENGTH_INTERVALS;
+		_arcLengths[i + 1] = _arcLengths[i] + IntegrateSpeed(_controlPoints, hodograph, _rational, a, b);
+	}
+
+	// Indicate the table matches the control points
+	_arcLengthVersion = _version;
+}
+
+void BezierCurve::BoundingBox(double box[4])
+{
+	// Calculate the box again if the control points changed
+	if (_boundingBoxVersion != _version) 
+	{
+		// Start with the control polygon box if there are no inner extremes to look for
+		int nPoints = _controlPoints->size();
+		if (nPoints < 3) 
+		{
+			ControlPolygonBox(_boundingBox);
+		}
+		else 
+		{
+			// Start with the first control point, the last one is the first candidate parameter
+			int n = nPoints - 1;
+			_boundingBox[0] = _boundingBox[2] = _controlPoints->_x[0];
+			_boundingBox[1] = _boundingBox[3] = _controlPoints->_y[0];
+			std::vector<double> roots(1, 1.0);
+
+			// Load the (weighted) control points and the first hodograph in double precision
+			const ControlPoints * hodograph = Hodograph(1);
+			std::vector<double> x(nPoints), y(nPoints), w(nPoints), dx(n), dy(n), dw(n);
+			for (int i = 0; i < nPoints; i += 1) 
+			{
+				w[i] = _rational ? _controlPoints->_w[i] : 1.0;
+				x[i] = w[i] * _controlPoints->_x[i];
+				y[i] = w[i] * _controlPoints->_y[i];
+			}
+			for (int i = 0; i < n; i += 1) 
+			{
+				dx[i] = hodograph->_x[i];
+				dy[i] = hodograph->_y[i];
+				dw[i] = hodograph->_w[i];
+			}
+
+			// The derivatives of the coordinates, the hodograph itself or X' W - X W' (degree 2n - 1) for rational curves
+			std::vector<double> gx(dx), gy(dy);
+			if (_rational) 
+			{
+				gx.assign(2 * n, 0.0);
+				gy.assign(2 * n, 0.0);
+				AddBernsteinProduct(dx.data(), n - 1, w.data(), n, 1.0, gx.data());
+				AddBernsteinProduct(x.data(), n, dw.data(), n - 1, -1.0, gx.data());
+				AddBernsteinProduct(dy.data(), n - 1, w.data(), n, 1.0, gy.data());
+				AddBernsteinProduct(y.data(), n, dw.data(), n - 1, -1.0, gy.data());
+			}
+
+			// Find the parameters where either coordinate stops increasing or decreasing
+			Utils::BernsteinRoots(gx.data(), gx.size(), BOUNDING_BOX_TOLERANCE, roots);
+			Utils::BernsteinRoots(gy.data(), gy.size(), BOUNDING_BOX_TOLERANCE, roots);
+
+			// Extend the box with the points at the candidate parameters
+			int nRoots = roots.size();
+			for (int i = 0; i < nRoots; i += 1) 
+			{
+				Point p = Evaluate(roots[i]);
+				_boundingBox[0] = (p.x < _boundingBox[0]) ? p.x : _boundingBox[0];
+				_boundingBox[1] = (p.y < _boundingBox[1]) ? p.y : _boundingBox[1];
+				_boundingBox[2] = (p.x > _boundingBox[2]) ? p.x : _boundingBox[2];
+				_boundingBox[3] = (p.y > _boundingBox[3]) ? p.y : _boundingBox[3];
+			}
+		}
+
+		// Indicate the box matches the control points
+		_boundingBoxVersion = _version;
+	}
+
+	// Copy the box
+	for (int i = 0; i < 4; i += 1) 
+	{
+		box[i] = _boundingBox[i];
+	}
+}
+
+void BezierCurve::Clear()
+{
+	// Remove the control points
+	_controlPoints->clear();
+	_version += 1;
+
+	// Get the number of stored degrees
+	int nDegrees = _degrees->size();
+	
+	// Traverse the degrees and delete them
+	for (int i = 0; i < nDegrees; i += 1) 
+	{
+		delete _degrees->at(i);
+	}
+
+	// Remove the deleted degrees from the vector
+	_degrees->clear();
+}
+
+CurveProjection BezierCurve::ClosestPoint(Point q)
+{
+	// Run a batch with a single query point
+	CurveProjection projection;
+	double x = q.x;
+	double y = q.y;
+	ClosestPoints(&x, &y, 1, &projection);
+	return projection;
+}
+
+void BezierCurve::ClosestPoints(const double * x, const double * y, size_t n, CurveProjection * out)
+{
+	// Get the number of control points
+	int nPoints = _controlPoints->size();
+
+	// A curve with less than two control points is a single point (or the origin)
+	if (nPoints < 2) 
+	{
+		Point p = Evaluate(0.0);
+		for (size_t i = 0; i < n; i += 1) 
+		{
+			double dx = x[i] - p.x;
+			double dy = y[i] - p.y;
+			out[i]._t = 0.0;
+			out[i]._x = p.x;
+			out[i]._y = p.y;
+			out[i]._distance = std::sqrt((dx * dx) + (dy * dy));
+		}
+		return;
+	}
+
+	// Get the products shared by every query (A, Bx and By one after the other)
+	ProjectionProducts();
+	int nCoefficients = _projectionProducts.size() / 3;
+	const double * a = _projectionProducts.data();
+	const double * bx = a + nCoefficients;
+	const double * by = bx + nCoefficients;
+
+	// The coefficients of the closest point condition and its roots (kept between calls)
+	static thread_local std::vector<double> coefficients;
+	static thread_local std::vector<double> roots;
+	coefficients.resize(nCoefficients);
+
+	for (size_t i = 0; i < n; i += 1) 
+	{
+		// Calculate the coefficients of (P(t) - q) . P'(t) for the query point
+		for (int k = 0; k < nCoefficients; k += 1) 
+		{
+			coefficients[k] = a[k] - (x[i] * bx[k]) - (y[i] * by[k]);
+		}
+
+		// Find its roots and add the ends of the curve as candidates
+		roots.clear();
+		Utils::BernsteinRoots(coefficients.data(), nCoefficients, CLOSEST_POINT_TOLERANCE, roots);
+		roots.push_back(0.0);
+		roots.push_back(1.0);
+
+		// Keep the candidate closest to the query point
+		double bestT = 0.0, bestX = 0.0, bestY = 0.0, bestDistance2 = -1.0;
+		int nRoots = roots.size();
+		for (int j = 0; j < nRoots; j += 1) 
+		{
+			Point p = Evaluate(roots[j]);
+			double dx = x[i] - p.x;
+			double dy = y[i] - p.y;
+			double distance2 = (dx * dx) + (dy * dy);
+			if (bestDistance2 < 0.0 || distance2 < bestDistance2) 
+			{
+				bestT = roots[j];
+				bestX = p.x;
+				bestY = p.y;
+				bestDistance2 = distance2;
+			}
+		}
+
+		// Store the closest point
+		out[i]._t = bestT;
+		out[i]._x = bestX;
+		out[i]._y = bestY;
+		out[i]._distance = std::sqrt(bestDistance2);
+	}
+}
+
+void BezierCurve::ComputeSPoint(double s, double l, double r)
+{
+	// Update the last s reparametrized parameter
+	_lastS = s;
+
+	// Update the last left reparametrized domain
+	_lastSLeft = l;
+
+	// Update the last right reparametrized domain
+	_lastSRight = r;
+
+	// Calculate the equivalent t value for the repatametrized domain
+	double t = ((-l) / (r - l)) + (((1.0) / (r - l)) * s);
+
+	// Get the point for the calculated t
+	_sPoint = Evaluate(t);
+}
+
+void BezierCurve::ComputeTicks(int n, bool arcLength)
+{
+	// If no ticks are to be drawn then exit the function
+	if (_controlPoints->size() < 1 || n < 1) 
+	{
+		return;
+	}
+
+	// Store the number of generated ticks and how they are placed
+	_nTicks = n;
+	_arcLengthTicks = arcLength;
+
+	// Calculate the parameter value for every tick
+	std::vector<double> t(n + 1);
+	if (arcLength) 
+	{
+		EqualArcLengthParameters(n, t.data());
+	}
+	else 
+	{
+		for (int i = 0; i <= n; i += 1) 
+		{
+			t[i] = (double)i / (double)n;
+		}
+	}
+
+	// Evaluate the curve at all of the ticks
+	_tickX.resize(n + 1);
+	_tickY.resize(n + 1);
+	EvaluateMany(t.data(), t.size(), _tickX.data(), _tickY.data());
+}
+
+Point BezierCurve::ControlPointAt(int index)
+{
+	return _controlPoints->at(index);
+}
+
+void BezierCurve::ControlPolygonBox(double box[4])
+{
+	// Get the number of control points
+	int nPoints = _controlPoints->size();
+
+	// If no control points yet then the box is the origin
+	if (nPoints == 0) 
+	{
+		box[0] = box[1] = box[2] = box[3] = 0.0;
+		return;
+	}
+
+	// Extend the box of the first control point with the others
+	box[0] = box[2] = _controlPoints->_x[0];
+	box[1] = box[3] = _controlPoints->_y[0];
+	for (int i = 1; i < nPoints; i += 1) 
+	{
+		double x = _controlPoints->_x[i];
+		double y = _controlPoints->_y[i];
+		box[0] = (x < box[0]) ? x : box[0];
+		box[1] = (y < box[1]) ? y : box[1];
+		box[2] = (x > box[2]) ? x : box[2];
+		box[3] = (y > box[3]) ? y : box[3];
+	}
+}
+
+const std::vector<int> & BezierCurve::ConvexHull()
+{
+	// Calculate the hull again if the control points changed
+	if (!_convexHull) 
+	{
+		_convexHull = new IncrementalHull();
+	}
+	if (_convexHullVersion != _version) 
+	{
+		_convexHull->Build(_controlPoints);
+		_convexHullVersion = _version;
+	}
+
+	// Return the indices of the vertices
+	return _convexHull->_hull;
+}
+
+std::vector<Point*>* BezierCurve::CopyControlPoints()
+{
+	// Return the pointer to the vector with the copy of the control points
+	return _controlPoints->ToPointVector();
+}
+
+std::vector<Point*>* BezierCurve::CurvePoints(double x, double y, int segments)
+{
+	// Initialize the vector where the curve points will be stored
+	std::vector<Point *> * curvePoints = new std::vector<Point *>();
+	curvePoints->reserve(segments + 1);
+
+	// Calculate the coordinates of the curve points
+	std::vector<double> curveX(segments + 1);
+	std::vector<double> curveY(segments + 1);
+	Sample(x, y, segments, curveX.data(), curveY.data());
+
+	// Store the curve points in the curve points vector
+	for (int j = 0; j <= segments; j += 1) 
+	{
+		curvePoints->push_back(new Point(curveX[j], curveY[j]));
+	}
+
+	// Return the pointer to the vector with the curve points
+	return curvePoints;
+}
+
+void BezierCurve::DeleteControlPoint(int index)
+{
+	// Check if the grid matches the control points before erasing the point
+	bool gridUpToDate = _controlPointGrid && _controlPointGridVersion == _version;
+
+	// Remove the point from the convex hull while it is still stored
+	bool hullUpdated = _convexHull && _convexHullVersion == _version && _convexHull->Erase(_controlPoints, index);
+
+	// Erase the control point at the given location
+	_controlPoints->erase(index);
+	_version += 1;
+
+	// Indicate the convex hull matches the control points
+	if (hullUpdated) 
+	{
+		_convexHullVersion = _version;
+	}
+
+	// Erase the point from the grid
+	if (gridUpToDate) 
+	{
+		_controlPointGrid->Erase(index);
+		_controlPointGridVersion = _version;
+	}
+}
+
+void BezierCurve::Draw(const glm::mat4 model, const glm::mat4 view, const glm::mat4 projection, bool drawControlPoints)
+{
+	// If there are more than 1 control points then draw the elements of the curve
+	if (_controlPoints->size() > 1) 
+	{
+		// Draw the convex hull
+		_drawableConvexHull->Draw(model, view, projection);
+
+		// Draw the polygon lines
+		_drawablePolygonLines->Draw(model, view, projection);
+
+		// Draw the DeCasteljau lines
+		_drawableDeCasteljauLines->Draw(model, view, projection);
+
+		// Draw the DeCasteljau points
+		_drawableDeCasteljauPoints->Draw(model, view, projection);
+
+		// Draw the curve lines
+		_drawableCurveLines->Draw(model, view, projection);
+
+		// Draw the curve ticks
+		_drawableCurveTicks->Draw(model, view, projection);
+
+		// Draw the curve t point
+		_drawableCurveTPoint->Draw(model, view, projection);
+
+		// Draw the curve s point
+		_drawableCurveSPoint->Draw(model, view, projection);
+	}
+
+	// Draw if there is at least one control point and it is indicated
+	if (_controlPoints->size() > 0 && drawControlPoints)
+	{
+		// Draw the control points
+		_drawableControlPoints->Draw(model, view, projection);
+	}
+}
+
+Point BezierCurve::Evaluate(double t)
+{
+	// Get the number of control points
+	int nPoints = _controlPoints->size();
+
+	// If no control points yet then return the origin
+	if (nPoints == 0) 
+	{
+		return Point();
+	}
+
+	// Use the fixed degree kernel if there is one for the number of control points (rational curves use the generic path)
+	switch (_rational ? 0 : nPoints) 
+	{
+	case 2: return EvaluateFixed<2>(_controlPoints, t);
+	case 3: return EvaluateFixed<3>(_controlPoints, t);
+	case 4: return EvaluateFixed<4>(_controlPoints, t);
+	case 5: return EvaluateFixed<5>(_controlPoints, t);
+	case 6: return EvaluateFixed<6>(_controlPoints, t);
+	case 7: return EvaluateFixed<7>(_controlPoints, t);
+	case 8: return EvaluateFixed<8>(_controlPoints, t);
+	}
+
+	// The stack storage for the DeCasteljau values of typical degree curves
+	double stackBuffer[4 * BEZIER_STACK_POINTS];
+
+	// The scratch buffer for curves with more control points than the stack storage supports
+	// NOTE: It is reused between calls, so it is only reallocated when a larger curve is evaluated
+	static thread_local std::vector<double> scratchBuffer;
+
+	// Point to the stack storage, or to the scratch buffer if the curve does not fit in it
+	double * buffer = stackBuffer;
+	if (nPoints > BEZIER_STACK_POINTS) 
+	{
+		if ((int)scratchBuffer.size() < 4 * nPoints) 
+		{
+			scratchBuffer.resize(4 * nPoints);
+		}
+
+		buffer = scratchBuffer.data();
+	}
+
+	// Split the buffer into the X, Y, Z and W values
+	double * x = buffer;
+	double * y = buffer + nPoints;
+	double * z = buffer + (2 * nPoints);
+	double * w = buffer + (3 * nPoints);
+
+	// Load the homogeneous coordinates of the control points (polynomial curves have weight 1)
+	for (int i = 0; i < nPoints; i += 1) 
+	{
+		w[i] = _rational ? _controlPoints->_w[i] : 1.0;
+		x[i] = w[i] * _controlPoints->_x[i];
+		y[i] = w[i] * _controlPoints->_y[i];
+		z[i] = w[i] * _controlPoints->_z[i];
+	}
+
+	// Calculate 1 - t
+	double _t = 1.0 - t;
+
+	// Run the DeCasteljau triangle in place, each level overwrites the values of the previous one
+	for (int n = nPoints - 1; n > 0; n -= 1) 
+	{
+		for (int i = 0; i < n; i += 1) 
+		{
+			x[i] = (_t * x[i]) + (t * x[i + 1]);
+			y[i] = (_t * y[i]) + (t * y[i + 1]);
+			z[i] = (_t * z[i]) + (t * z[i + 1]);
+			w[i] = (_t * w[i]) + (t * w[i + 1]);
+		}
+	}
+
+	// The first value holds the curve point, project it back from homogeneous coordinates
+	return Point(x[0] / w[0], y[0] / w[0], z[0] / w[0]);
+}
+
+void BezierCurve::EqualArcLengthParameters(int n, double * outT)
+{
+	// Get the length of the curve
+	ArcLengthTable();
+	double length = _arcLengths[ARC_LENGTH_INTERVALS];
+
+	// Find the parameter of every part (the first and last ones are exact)
+	outT[0] = 0.0;
+	for (int i = 1; i < n; i += 1) 
+	{
+		outT[i] = ParamAtLength((length * (double)i) / (double)n);
+	}
+	outT[n] = 1.0;
+}
+
+void BezierCurve::EvaluateFrames(const double * t, size_t n, CurveFrames & frames)
+{
+	// Make room for the values of every parameter
+	frames._x.resize(n);
+	frames._y.resize(n);
+	frames._tangentX.resize(n);
+	frames._tangentY.resize(n);
+	frames._normalX.resize(n);
+	frames._normalY.resize(n);
+	frames._curvature.resize(n);
+
+	// Get the number of control points and the degree of the curve
+	int nPoints = _controlPoints->size();
+	double degree = (double)(nPoints - 1);
+
+	// If no control points yet then every value is zero
+	if (nPoints == 0) 
+	{
+		for (size_t k = 0; k < n; k += 1) 
+		{
+			frames._x[k] = frames._y[k] = 0.0;
+			frames._tangentX[k] = frames._tangentY[k] = 0.0;
+			frames._normalX[k] = frames._normalY[k] = 0.0;
+			frames._curvature[k] = 0.0;
+		}
+		return;
+	}
+
+	// Use the fixed degree kernel if there is one for the number of control points (rational curves use the generic path)
+	switch (_rational ? 0 : nPoints) 
+	{
+	case 2: EvaluateFramesFixed<2>(_controlPoints, t, n, frames); return;
+	case 3: EvaluateFramesFixed<3>(_controlPoints, t, n, frames); return;
+	case 4: EvaluateFramesFixed<4>(_controlPoints, t, n, frames); return;
+	case 5: EvaluateFramesFixed<5>(_controlPoints, t, n, frames); return;
+	case 6: EvaluateFramesFixed<6>(_controlPoints, t, n, frames); return;
+	case 7: EvaluateFramesFixed<7>(_controlPoints, t, n, frames); return;
+	case 8: EvaluateFramesFixed<8>(_controlPoints, t, n, frames); return;
+	}
+
+	// The number of doubles required for the X, Y and W DeCasteljau lanes
+	int bufferSize = 3 * nPoints * Simd::LANES;
+
+	// The stack storage for the DeCasteljau lanes of typical degree curves
+	double stackBuffer[3 * BEZIER_STACK_POINTS * Simd::LANES];
+
+	// The scratch buffer for curves with more control points than the stack storage supports
+	static thread_local std::vector<double> scratchBuffer;
+
+	// Point to the stack storage, or to the scratch buffer if the curve does not fit in it
+	double * buffer = stackBuffer;
+	if (nPoints > BEZIER_STACK_POINTS) 
+	{
+		if ((int)scratchBuffer.size() < bufferSize) 
+		{
+			scratchBuffer.resize(bufferSize);
+		}
+
+		buffer = scratchBuffer.data();
+	}
+
+	// Split the buffer into the X, Y and W lanes (one group of lanes per control point)
+	double * x = buffer;
+	double * y = buffer + (nPoints * Simd::LANES);
+	double * w = buffer + (2 * nPoints * Simd::LANES);
+
+	// The first and second differences of the last levels (zero when the curve has not enough control points)
+	double dx[Simd::LANES], dy[Simd::LANES], dw[Simd::LANES];
+	double ddx[Simd::LANES], ddy[Simd::LANES], ddw[Simd::LANES];
+
+	// Traverse through the parameters, one group of lanes at a time
+	for (size_t k = 0; k < n; k += Simd::LANES) 
+	{
+		// Get the number of parameters in the current group
+		int count = (n - k < (size_t)Simd::LANES) ? (int)(n - k) : Simd::LANES;
+
+		// Load the parameters of the group (unused lanes repeat the last parameter)
+		double lanesT[Simd::LANES];
+		for (int l = 0; l < Simd::LANES; l += 1) 
+		{
+			lanesT[l] = t[k + (l < count ? l : count - 1)];
+			dx[l] = dy[l] = dw[l] = 0.0;
+			ddx[l] = ddy[l] = ddw[l] = 0.0;
+		}
+		Simd::Double vt = Simd::Load(lanesT);
+		Simd::Double v_t = Simd::Sub(Simd::Set1(1.0), vt);
+
+		// Load the control points into every lane (in homogeneous coordinates, polynomial curves have weight 1)
+		for (int i = 0; i < nPoints; i += 1) 
+		{
+			double weight = _rational ? _controlPoints->_w[i] : 1.0;
+			Simd::Store(x + (i * Simd::LANES), Simd::Set1(weight * _controlPoints->_x[i]));
+			Simd::Store(y + (i * Simd::LANES), Simd::Set1(weight * _controlPoints->_y[i]));
+			Simd::Store(w + (i * Simd::LANES), Simd::Set1(weight));
+		}
+
+		// Run the DeCasteljau triangle in place for all of the lanes
+		for (int m = nPoints - 1; m > 0; m -= 1) 
+		{
+			// With three points left store their second differences, with two points left store their first differences
+			if (m == 2 || m == 1) 
+			{
+				for (int l = 0; l < Simd::LANES; l += 1) 
+				{
+					int i0 = l;
+					int i1 = Simd::LANES + l;
+					if (m == 2) 
+					{
+						int i2 = (2 * Simd::LANES) + l;
+						ddx[l] = x[i0] - (2.0 * x[i1]) + x[i2];
+						ddy[l] = y[i0] - (2.0 * y[i1]) + y[i2];
+						ddw[l] = w[i0] - (2.0 * w[i1]) + w[i2];
+					}
+					else 
+					{
+						dx[l] = x[i1] - x[i0];
+						dy[l] = y[i1] - y[i0];
+						dw[l] = w[i1] - w[i0];
+					}
+				}
+			}
+
+			for (int i = 0; i < m; i += 1) 
+			{
+				double * xi = x + (i * Simd::LANES);
+				double * yi = y + (i * Simd::LANES);
+				double * wi = w + (i * Simd::LANES);
+				Simd::Store(xi, Simd::MulAdd(v_t, Simd::Load(xi), Simd::Mul(vt, Simd::Load(xi + Simd::LANES))));
+				Simd::Store(yi, Simd::MulAdd(v_t, Simd::Load(yi), Simd::Mul(vt, Simd::Load(yi + Simd::LANES))));
+				Simd::Store(wi, Simd::MulAdd(v_t, Simd::Load(wi), Simd::Mul(vt, Simd::Load(wi + Simd::LANES))));
+			}
+		}
+
+		// Calculate the values of every parameter of the group
+		for (int l = 0; l < count; l += 1) 
+		{
+			// Get the point and its derivatives in homogeneous coordinates
+			double firstScale = degree;
+			double secondScale = degree * (degree - 1.0);
+			double W = w[l];
+			double W1 = firstScale * dw[l];
+			double W2 = secondScale * ddw[l];
+
+			// Project the point and apply the quotient rule to the derivatives (W is 1 and its derivatives 0 for polynomial curves)
+			double px = x[l] / W;
+			double py = y[l] / W;
+			double x1 = ((firstScale * dx[l]) - (px * W1)) / W;
+			double y1 = ((firstScale * dy[l]) - (py * W1)) / W;
+			double x2 = ((secondScale * ddx[l]) - (2.0 * x1 * W1) - (px * W2)) / W;
+			double y2 = ((secondScale * ddy[l]) - (2.0 * y1 * W1) - (py * W2)) / W;
+
+			// Store the point and its frame
+			StoreFrame(frames, k + l, px, py, x1, y1, x2, y2);
+		}
+	}
+}
+
+void BezierCurve::EvaluateMany(const double * t, size_t n, double * outX, double * outY)
+{
+	// Get the number of control points
+	int nPoints = _controlPoints->size();
+
+	// If no control points yet then return the origin for every parameter
+	if (nPoints == 0) 
+	{
+		for (size_t k = 0; k < n; k += 1) 
+		{
+			outX[k] = 0.0;
+			outY[k] = 0.0;
+		}
+		return;
+	}
+
+	// Use the fixed degree kernel if there is one for the number of control points (rational curves use the generic path)
+	switch (_rational ? 0 : nPoints) 
+	{
+	case 2: EvaluateManyFixed<2>(_controlPoints, t, n, outX, outY); return;
+	case 3: EvaluateManyFixed<3>(_controlPoints, t, n, outX, outY); return;
+	case 4: EvaluateManyFixed<4>(_controlPoints, t, n, outX, outY); return;
+	case 5: EvaluateManyFixed<5>(_controlPoints, t, n, outX, outY); return;
+	case 6: EvaluateManyFixed<6>(_controlPoints, t, n, outX, outY); return;
+	case 7: EvaluateManyFixed<7>(_controlPoints, t, n, outX, outY); return;
+	case 8: EvaluateManyFixed<8>(_controlPoints, t, n, outX, outY); return;
+	}
+
+	// The number of doubles required for the X, Y and W DeCasteljau lanes
+	int bufferSize = 3 * nPoints * Simd::LANES;
+
+	// The stack storage for the DeCasteljau lanes of typical degree curves
+	double stackBuffer[3 * BEZIER_STACK_POINTS * Simd::LANES];
 
-BezierCurve::BezierCurve() : 
-	_controlPoints(new std::vector<Point *>()), 
-	_degrees(new std::vector<std::vector<Point *> *>()), 
-	_drawableCurveLines(new DrawableLines()), 
-	_drawablePolygonLines(new DrawableLines()), 
-	_drawableDeCasteljauLines(new DrawableLines()), 
-	_drawableDeCasteljauPoints(new DrawablePoints()), 
-	_drawableControlPoints(new DrawablePoints()), 
-	_drawableCurveTPoint(new DrawablePoints()), 
-	_drawableCurveSPoint(new DrawablePoints()),
-	_drawableCurveTicks(new DrawablePoints()), 
-	_drawableConvexHull(new DrawablePolygon()), 
-	_deCasteljauT(-1.0f), 
-	_lastX(-1.0), 
-	_lastY(-1.0), 
-	_lastS(-1.0), 
-	_lastSLeft(-1.0), 
-	_lastSRight(-1.0)
+	// The scratch buffer for curves with more control points than the stack storage supports
+	static thread_local std::vector<double> scratchBuffer;
+
+	// Point to the stack storage, or to the scratch buffer if the curve does not fit in it
+	double * buffer = stackBuffer;
+	if (nPoints > BEZIER_STACK_POINTS) 
+	{
+		if ((int)scratchBuffer.size() < bufferSize) 
+		{
+			scratchBuffer.resize(bufferSize);
+		}
+
+		buffer = scratchBuffer.data();
+	}
+
+	// Split the buffer into the X, Y and W lanes (one group of lanes per control point)
+	// NOTE: The W lanes are only used by rational curves
+	double * x = buffer;
+	double * y = buffer + (nPoints * Simd::LANES);
+	double * w = buffer + (2 * nPoints * Simd::LANES);
+
+	// Traverse through the parameters, one group of lanes at a time
+	for (size_t k = 0; k < n; k += Simd::LANES) 
+	{
+		// Get the number of parameters in the current group
+		int count = (n - k < (size_t)Simd::LANES) ? (int)(n - k) : Simd::LANES;
+
+		// Load the parameters of the group (unused lanes repeat the last parameter)
+		double lanesT[Simd::LANES];
+		for (int l = 0; l < Simd::LANES; l += 1) 
+		{
+			lanesT[l] = t[k + (l < count ? l : count - 1)];
+		}
+		Simd::Double vt = Simd::Load(lanesT);
+		Simd::Double v_t = Simd::Sub(Simd::Set1(1.0), vt);
+
+		// Load the control points into every lane (in homogeneous coordinates for rational curves)
+		for (int i = 0; i < nPoints; i += 1) 
+		{
+			double weight = _rational ? _controlPoints->_w[i] : 1.0;
+			Simd::Store(x + (i * Simd::LANES), Simd::Set1(weight * _controlPoints->_x[i]));
+			Simd::Store(y + (i * Simd::LANES), Simd::Set1(weight * _controlPoints->_y[i]));
+			Simd::Store(w + (i * Simd::LANES), Simd::Set1(weight));
+		}
+
+		// Run the DeCasteljau triangle in place for all of the lanes
+		for (int m = nPoints - 1; m > 0; m -= 1) 
+		{
+			for (int i = 0; i < m; i += 1) 
+			{
+				double * xi = x + (i * Simd::LANES);
+				double * yi = y + (i * Simd::LANES);
+				Simd::Store(xi, Simd::MulAdd(v_t, Simd::Load(xi), Simd::Mul(vt, Simd::Load(xi + Simd::LANES))));
+				Simd::Store(yi, Simd::MulAdd(v_t, Simd::Load(yi), Simd::Mul(vt, Simd::Load(yi + Simd::LANES))));
+			}
+
+			// Run the same level over the weights of rational curves
+			if (_rational) 
+			{
+				for (int i = 0; i < m; i += 1) 
+				{
+					double * wi = w + (i * Simd::LANES);
+					Simd::Store(wi, Simd::MulAdd(v_t, Simd::Load(wi), Simd::Mul(vt, Simd::Load(wi + Simd::LANES))));
+				}
+			}
+		}
+
+		// Store the curve points of the group (projected back from homogeneous coordinates for rational curves)
+		for (int l = 0; l < count; l += 1) 
+		{
+			outX[k + l] = _rational ? x[l] / w[l] : x[l];
+			outY[k + l] = _rational ? y[l] / w[l] : y[l];
+		}
+	}
+}
+
+int BezierCurve::FindControlPoint(double x, double y, double halfSize)
 {
+	// Build the grid again if the squares changed their size or the control points changed
+	if (!_controlPointGrid || _controlPointGrid->_cellSize != 2.0 * halfSize) 
+	{
+		delete _controlPointGrid;
+		_controlPointGrid = new ControlPointGrid(2.0 * halfSize);
+		_controlPointGridVersion = -1;
+	}
+	if (_controlPointGridVersion != _version) 
+	{
+		_controlPointGrid->Build(_controlPoints);
+		_controlPointGridVersion = _version;
+	}
+
+	// Find the control point in the grid
+	return _controlPointGrid->Find(_controlPoints, x, y, halfSize);
 }
 
-BezierCurve::~BezierCurve()
+void BezierCurve::ForwardDifferences(double x, double y, int segments, double * outX, double * outY)
 {
-	// Delete the control points vector
-	Utils::DeletePointVector(_controlPoints);
+	// Get the number of control points
+	int nPoints = _controlPoints->size();
 
-	// Get the number of degrees stored
+	// Get the seed matrices for the current tessellation
+	std::shared_ptr<const ForwardDifferenceSeeds> seeds = GetForwardDifferenceSeeds(nPoints, x, y, segments, _reseedInterval);
+
+	// The forward differences (a value for each control point)
+	std::vector<double> diffX(nPoints);
+	std::vector<double> diffY(nPoints);
+
+	// Get the number of seeds and the size of every matrix
+	int nSeeds = seeds->_indices.size();
+	int matrixSize = nPoints * nPoints;
+
+	// Traverse through the seeds
+	for (int s = 0; s < nSeeds; s += 1) 
+	{
+		const double * matrix = &seeds->_matrices[s * matrixSize];
+
+		// Seed the forward differences from the control points
+		for (int m = 0; m < nPoints; m += 1) 
+		{
+			double dx = 0.0;
+			double dy = 0.0;
+			for (int i = 0; i < nPoints; i += 1) 
+			{
+				dx += matrix[(m * nPoints) + i] * _controlPoints->_x[i];
+				dy += matrix[(m * nPoints) + i] * _controlPoints->_y[i];
+			}
+			diffX[m] = dx;
+			diffY[m] = dy;
+		}
+
+		// Get the range of curve points generated from the current seed
+		int first = seeds->_indices.at(s);
+		int last = (s + 1 < nSeeds) ? seeds->_indices.at(s + 1) : segments + 1;
+
+		// Emit the curve points, each one only costs nPoints additions
+		for (int j = first; j < last; j += 1) 
+		{
+			// Store the current curve point
+			outX[j] = diffX[0];
+			outY[j] = diffY[0];
+
+			// Advance the differences to the next curve point
+			for (int m = 0; m < nPoints - 1; m += 1) 
+			{
+				diffX[m] += diffX[m + 1];
+				diffY[m] += diffY[m + 1];
+			}
+		}
+	}
+}
+
+const ControlPoints * BezierCurve::Hodograph(int order)
+{
+	// Only the first and the second derivatives are stored
+	if (order != 1 && order != 2) 
+	{
+		return NULL;
+	}
+
+	// Calculate the hodographs again if the control points changed
+	if (_hodographVersion != _version) 
+	{
+		// Get the number of control points
+		int nPoints = _controlPoints->size();
+
+		// Remove the previous hodographs
+		_firstHodograph->clear();
+		_secondHodograph->clear();
+
+		// Use the fixed degree kernel if there is one for the number of control points (rational curves use the generic path)
+		switch (_rational ? 0 : nPoints) 
+		{
+		case 2: HodographsFixed<2>(_controlPoints, _firstHodograph, _secondHodograph); break;
+		case 3: HodographsFixed<3>(_controlPoints, _firstHodograph, _secondHodograph); break;
+		case 4: HodographsFixed<4>(_controlPoints, _firstHodograph, _secondHodograph); break;
+		case 5: HodographsFixed<5>(_controlPoints, _firstHodograph, _secondHodograph); break;
+		case 6: HodographsFixed<6>(_controlPoints, _firstHodograph, _secondHodograph); break;
+		case 7: HodographsFixed<7>(_controlPoints, _firstHodograph, _secondHodograph); break;
+		case 8: HodographsFixed<8>(_controlPoints, _firstHodograph, _secondHodograph); break;
+		default: HodographsGeneric(_controlPoints, _rational, _firstHodograph, _secondHodograph); break;
+		}
+
+		// Indicate the hodographs match the control points
+		_hodographVersion = _version;
+	}
+
+	// Return the requested hodograph
+	return (order == 1) ? _firstHodograph : _secondHodograph;
+}
+
+double BezierCurve::LengthAt(double t)
+{
+	// Clamp the parameter to [0, 1]
+	t = (t < 0.0) ? 0.0 : ((t > 1.0) ? 1.0 : t);
+
+	// Get the table entry at or before the parameter
+	ArcLengthTable();
+	int i = (int)(t * ARC_LENGTH_INTERVALS);
+	i = (i < ARC_LENGTH_INTERVALS) ? i : ARC_LENGTH_INTERVALS - 1;
+
+	// Add the length from the table entry to the parameter
+	double a = (double)i / (double)ARC_LENGTH_INTERVALS;
+	return _arcLengths[i] + IntegrateSpeed(_controlPoints, Hodograph(1), _rational, a, t);
+}
+
+void BezierCurve::LowerDegree()
+{
 	int nDegrees = _degrees->size();
 
-	// Traverse through the degrees and delete them
-	for (int i = 0; i < nDegrees; i += 1) 
+	if (nDegrees > 0) 
 	{
-		Utils::DeletePointVector(_degrees->at(i));
+		delete _controlPoints;
+
+		_controlPoints = _degrees->at(nDegrees - 1);
+
+		_degrees->pop_back();
+
+		_version += 1;
 	}
 
-	// Delete the degrees vector
-	delete _degrees;
+	// If there are no stored degrees then reduce the degree by one
+	else if (_controlPoints->size() > 2) 
+	{
+		ReduceDegree(_controlPoints->size() - 1);
+	}
 }
 
-void BezierCurve::AddControlPoint(double x, double y)
+bool BezierCurve::MoveControlPoint(int index, double x, double y)
 {
-	// Add the new point to the control points vector and indicate the geometries has been updated
-	_controlPoints->push_back(new Point(x, y));
+	// Check if the curve points match the control points before moving the point
+	// NOTE: The curve points of rational curves do not move linearly with a control point, they are always calculated again
+	bool upToDate = _curveVersion == _version && _tessellationMode != TESSELLATION_ADAPTIVE && !_rational && _curveX.size() > 1;
+
+	// Get the current coordinates of the control point
+	double previousX = _controlPoints->_x[index];
+	double previousY = _controlPoints->_y[index];
+
+	// Update the coordinates of the control point
+	SetControlPoint(index, x, y);
+
+	// If the curve points do not match the control points then they have to be calculated again
+	if (!upToDate) 
+	{
+		return false;
+	}
+
+	// Get the number of control points and curve points
+	int nPoints = _controlPoints->size();
+	int nCurvePoints = _curveX.size();
+
+	// If the stored basis matrix belongs to another degree, domain or number of curve points then get the right one
+	if (!_basis || _basis->_nPoints != nPoints || _basis->_x != _lastX || _basis->_y != _lastY || _basis->_segments != nCurvePoints - 1) 
+	{
+		_basis = BernsteinBasis::Get(nPoints, _lastX, _lastY, nCurvePoints - 1);
+	}
+
+	// Get the displacement of the control point (using the stored coordinates, so it matches the control points)
+	double dx = _controlPoints->_x[index] - previousX;
+	double dy = _controlPoints->_y[index] - previousY;
+
+	// Get the pointers to the curve points and the Bernstein values
+	double * curveX = _curveX.data();
+	double * curveY = _curveY.data();
+	const double * basis = _basis->Column(index);
+
+	// Add the displacement scaled by the Bernstein values, Simd::LANES curve points at a time
+	Simd::Double vdx = Simd::Set1(dx);
+	Simd::Double vdy = Simd::Set1(dy);
+	int j = 0;
+	for (; j + Simd::LANES <= nCurvePoints; j += Simd::LANES) 
+	{
+		Simd::Double vb = Simd::Load(basis + j);
+		Simd::Store(curveX + j, Simd::MulAdd(vdx, vb, Simd::Load(curveX + j)));
+		Simd::Store(curveY + j, Simd::MulAdd(vdy, vb, Simd::Load(curveY + j)));
+	}
+
+	// Update the remaining curve points
+	for (; j < nCurvePoints; j += 1) 
+	{
+		curveX[j] += dx * basis[j];
+		curveY[j] += dy * basis[j];
+	}
+
+	// Indicate the curve points match the moved control points
+	_curveVersion = _version;
+
+	return true;
 }
 
-void BezierCurve::Clear()
+double BezierCurve::ParamAtLength(double s)
+{
+	// Get the length of the curve, if it has no length then every parameter is valid
+	ArcLengthTable();
+	double length = _arcLengths[ARC_LENGTH_INTERVALS];
+	if (length <= 0.0) 
+	{
+		return 0.0;
+	}
+
+	// Clamp the arc length
+	s = (s < 0.0) ? 0.0 : ((s > length) ? length : s);
+
+	// Find the interval of the table containing the arc length
+	int i = (int)(std::upper_bound(_arcLengths.begin(), _arcLengths.end(), s) - _arcLengths.begin()) - 1;
+	i = (i < 0) ? 0 : ((i < ARC_LENGTH_INTERVALS) ? i : ARC_LENGTH_INTERVALS - 1);
+
+	// Get the bracket of the parameter and the first guess interpolating the table linearly
+	double a = (double)i / (double)ARC_LENGTH_INTERVALS;
+	double lo = a;
+	double hi = (double)(i + 1) / (double)ARC_LENGTH_INTERVALS;
+	double intervalLength = _arcLengths[i + 1] - _arcLengths[i];
+	double t = (intervalLength > 0.0) ? a + (((s - _arcLengths[i]) / intervalLength) * (hi - lo)) : a;
+
+	// Refine the parameter using Newton's iteration
+	const ControlPoints * hodograph = Hodograph(1);
+	for (int k = 0; k < ARC_LENGTH_MAX_ITERATIONS; k += 1) 
+	{
+		// Get the difference between the arc length at the parameter and the given one
+		double f = _arcLengths[i] + IntegrateSpeed(_controlPoints, hodograph, _rational, a, t) - s;
+		if (std::fabs(f) <= 1e-12 * length) 
+		{
+			break;
+		}
+
+		// Shrink the bracket
+		if (f > 0.0) 
+		{
+			hi = t;
+		}
+		else 
+		{
+			lo = t;
+		}
+
+		// Take the Newton step, or bisect the bracket if the step leaves it
+		double speed = Speed(_controlPoints, hodograph, _rational, t);
+		double next = (speed > 0.0) ? t - (f / speed) : lo - 1.0;
+		t = (next > lo && next < hi) ? next : 0.5 * (lo + hi);
+	}
+
+	// Return the parameter
+	return t;
+}
+
+Point * BezierCurve::PointAt(double t)
+{
+	// If no control points yet return null
+	if (_controlPoints->size() == 0) 
+	{
+		return NULL;
+	}
+
+	// Return a pointer to a copy of the evaluated point
+	return new Point(Evaluate(t));
+}
+
+void BezierCurve::ProjectionProducts()
+{
+	// If the products match the control points then exit the function
+	if (_projectionVersion == _version) 
+	{
+		return;
+	}
+
+	// Remove the previous products
+	_projectionProducts.clear();
+	_projectionVersion = _version;
+
+	// Get the number of control points and the degree, there is nothing to project onto with less than two control points
+	int nPoints = _controlPoints->size();
+	int n = nPoints - 1;
+	if (nPoints < 2) 
+	{
+		return;
+	}
+
+	// Load the (weighted) control points and the first hodograph in double precision
+	const ControlPoints * hodograph = Hodograph(1);
+	std::vector<double> x(nPoints), y(nPoints), w(nPoints), dx(n), dy(n), dw(n);
+	for (int i = 0; i < nPoints; i += 1) 
+	{
+		w[i] = _rational ? _controlPoints->_w[i] : 1.0;
+		x[i] = w[i] * _controlPoints->_x[i];
+		y[i] = w[i] * _controlPoints->_y[i];
+	}
+	for (int i = 0; i < n; i += 1) 
+	{
+		dx[i] = hodograph->_x[i];
+		dy[i] = hodograph->_y[i];
+		dw[i] = hodograph->_w[i];
+	}
+
+	// The direction of the tangent, the hodograph itself or X' W - X W' (degree 2n - 1) for rational curves
+	int g = n - 1;
+	std::vector<double> gx(dx), gy(dy);
+	if (_rational) 
+	{
+		g = (2 * n) - 1;
+		gx.assign(g + 1, 0.0);
+		gy.assign(g + 1, 0.0);
+		AddBernsteinProduct(dx.data(), n - 1, w.data(), n, 1.0, gx.data());
+		AddBernsteinProduct(x.data(), n, dw.data(), n - 1, -1.0, gx.data());
+		AddBernsteinProduct(dy.data(), n - 1, w.data(), n, 1.0, gy.data());
+		AddBernsteinProduct(y.data(), n, dw.data(), n - 1, -1.0, gy.data());
+	}
+
+	// Calculate A = X . G, Bx = W Gx and By = W Gy
+	int nCoefficients = n + g + 1;
+	_projectionProducts.assign(3 * nCoefficients, 0.0);
+	double * a = _projectionProducts.data();
+	double * bx = a + nCoefficients;
+	double * by = bx + nCoefficients;
+	AddBernsteinProduct(x.data(), n, gx.data(), g, 1.0, a);
+	AddBernsteinProduct(y.data(), n, gy.data(), g, 1.0, a);
+	AddBernsteinProduct(w.data(), n, gx.data(), g, 1.0, bx);
+	AddBernsteinProduct(w.data(), n, gy.data(), g, 1.0, by);
+}
+
+void BezierCurve::RaiseDegree()
+{
+	// If there are less than two control points then exit the function
+	if (_controlPoints->size() < 2) 
+	{
+		return;
+	}
+
+	// Get the number of control points
+	int nPoints = _controlPoints->size();
+
+	// Load the control points into the scratch buffer (rational curves are raised in homogeneous coordinates)
+	static thread_local std::vector<double> scratchBuffer;
+	const double * x = LoadWeighted(_controlPoints, _rational, scratchBuffer);
+	const double * y = x + nPoints;
+	const double * z = y + nPoints;
+	const double * w = z + nPoints;
+
+	// Initialize the control points for the next degree
+	ControlPoints * nextDegreePoints = new ControlPoints();
+	nextDegreePoints->reserve(nPoints + 1);
+
+	// Push a copy of the first control point into the next degree points
+	nextDegreePoints->push_back(_controlPoints->_x[0], _controlPoints->_y[0], _controlPoints->_z[0], _controlPoints->_w[0]);
+
+	// Generate the control points for the new degree
+	for (int i = 1; i < nPoints; i += 1) 
+	{
+		// Calculate the common value for both points
+		// NOTE: The actual value is (i / (n + 1)), since nPoints is already (n + 1) then let's use it
+		double val = (double)i / ((double)nPoints);
+
+		// Combine the previous and the current control points
+		PushProjected(nextDegreePoints, _rational, 
+			(val * x[i - 1]) + ((1.0 - val) * x[i]), 
+			(val * y[i - 1]) + ((1.0 - val) * y[i]), 
+			(val * z[i - 1]) + ((1.0 - val) * z[i]), 
+			(val * w[i - 1]) + ((1.0 - val) * w[i]));
+	}
+
+	// Push a copy of the last control point into the next degree points
+	nextDegreePoints->push_back(_controlPoints->_x[nPoints - 1], _controlPoints->_y[nPoints - 1], _controlPoints->_z[nPoints - 1], _controlPoints->_w[nPoints - 1]);
+
+	// Store the current control points in the degrees vector
+	_degrees->push_back(_controlPoints);
+
+	// Set the new degree points as the control points of the curve
+	_controlPoints = nextDegreePoints;
+	_version += 1;
+
+	// NOTE: It is assumed a curve update is performed after this function
+}
+
+void BezierCurve::RaiseDegreeBy(int r)
+{
+	// If there are less than two control points or nothing to raise then exit the function
+	if (_controlPoints->size() < 2 || r < 1) 
+	{
+		return;
+	}
+
+	// Get the number of control points
+	int nPoints = _controlPoints->size();
+
+	// Get the elevation matrix for the number of control points and degrees
+	std::shared_ptr<const std::vector<double>> matrix = GetElevationMatrix(nPoints, r);
+
+	// Load the control points into the scratch buffer (rational curves are raised in homogeneous coordinates)
+	static thread_local std::vector<double> scratchBuffer;
+	const double * px = LoadWeighted(_controlPoints, _rational, scratchBuffer);
+	const double * py = px + nPoints;
+	const double * pz = py + nPoints;
+	const double * pw = pz + nPoints;
+
+	// Initialize the control points for the new degree
+	ControlPoints * raisedPoints = new ControlPoints();
+	raisedPoints->reserve(nPoints + r);
+
+	// Calculate every new control point from the band of its row
+	for (int j = 0; j < nPoints + r; j += 1) 
+	{
+		const double * weights = matrix->data() + (j * nPoints);
+		int first = (j - r > 0) ? j - r : 0;
+		int last = (j < nPoints - 1) ? j : nPoints - 1;
+		double x = 0.0;
+		double y = 0.0;
+		double z = 0.0;
+		double w = 0.0;
+		for (int i = first; i <= last; i += 1) 
+		{
+			x += weights[i] * px[i];
+			y += weights[i] * py[i];
+			z += weights[i] * pz[i];
+			w += weights[i] * pw[i];
+		}
+		PushProjected(raisedPoints, _rational, x, y, z, w);
+	}
+
+	// Store the current control points in the degrees vector (a single entry, so lowering the degree undoes all of the steps)
+	_degrees->push_back(_controlPoints);
+
+	// Set the new degree points as the control points of the curve
+	_controlPoints = raisedPoints;
+	_version += 1;
+
+	// NOTE: It is assumed a curve update is performed after this function
+}
+
+double BezierCurve::ReduceDegree(int m)
 {
+	// Get the number of control points
+	int nPoints = _controlPoints->size();
+
+	// If the number of control points cannot be reduced to m then exit the function
+	// NOTE: Rational curves are not reduced, since the fit of their weights may not be positive and the bound of the weighted
+	// control points does not bound the distance between the projected curves
+	if (m < 2 || m >= nPoints || _rational) 
+	{
+		return 0.0;
+	}
+
+	// Get the reduction matrix for the number of control points
+	std::shared_ptr<const std::vector<double>> matrix = GetReductionMatrix(nPoints, m);
+
+	// Initialize the control points for the reduced degree
+	ControlPoints * reducedPoints = new ControlPoints();
+	reducedPoints->reserve(m);
+
+	// Calculate every reduced control point as a weighted sum of the control points
+	for (int r = 0; r < m; r += 1) 
+	{
+		const double * weights = matrix->data() + (r * nPoints);
+		double x = 0.0;
+		double y = 0.0;
+		double z = 0.0;
+		double w = 0.0;
+		for (int i = 0; i < nPoints; i += 1) 
+		{
+			x += weights[i] * _controlPoints->_x[i];
+			y += weights[i] * _controlPoints->_y[i];
+			z += weights[i] * _controlPoints->_z[i];
+			w += weights[i] * _controlPoints->_w[i];
+		}
+		reducedPoints->push_back(x, y, z, w);
+	}
+
+	// Elevate the reduced control points back to the original degree and find the farthest one from its original control point
+	// NOTE: The distance between both curves is a convex combination of these distances, so the largest one bounds it
+	std::shared_ptr<const std::vector<double>> elevation = GetElevationMatrix(m, nPoints - m);
+	double bound = 0.0;
+	for (int j = 0; j < nPoints; j += 1) 
+	{
+		const double * weights = elevation->data() + (j * m);
+		double dx = -_controlPoints->_x[j];
+		double dy = -_controlPoints->_y[j];
+		double dz = -_controlPoints->_z[j];
+		for (int i = 0; i < m; i += 1) 
+		{
+			dx += weights[i] * reducedPoints->_x[i];
+			dy += weights[i] * reducedPoints->_y[i];
+			dz += weights[i] * reducedPoints->_z[i];
+		}
+		double distance = std::sqrt((dx * dx) + (dy * dy) + (dz * dz));
+		bound = (distance > bound) ? distance : bound;
+	}
+
 	// Delete the control points
-	Utils::DeletePointVector(_controlPoints);
+	delete _controlPoints;
 
 	// Get the number of stored degrees
 	int nDegrees = _degrees->size();
-	
-	// Traverse the degrees and delete them
-	for (int i = 0; i < nDegrees; i += 1) 
+
+	// Traverse the degrees and delete them (they no longer describe the same curve)
+	for (int i = 0; i < nDegrees; i += 1)
 	{
-		Utils::DeletePointVector(_degrees->at(i));
+		delete _degrees->at(i);
 	}
 
-	// Delete the degrees vector
-	delete _degrees;
+	// Remove the deleted degrees from the vector
+	_degrees->clear();
+
+	// Set the reduced points as the control points of the curve
+	_controlPoints = reducedPoints;
+	_version += 1;
 
-	// Initialize the vectors
-	_controlPoints = new std::vector<Point *>();
-	_degrees = new std::vector<std::vector<Point *> *>();
+	// NOTE: It is assumed a curve update is performed after this function
+
+	// Return the error bound
+	return bound;
 }
 
-std::vector<Point*>* BezierCurve::CopyControlPoints()
+void BezierCurve::Sample(double x, double y, int segments, double * outX, double * outY)
 {
-	// Initialize the vector for storing the copy of the control points
-	std::vector<Point *> * copiedPoints = new std::vector<Point *>();
+	// If forward differences are used then generate the points with them (rational curves use the basis matrix instead)
+	if (_tessellationMode == TESSELLATION_FORWARD_DIFFERENCES && _controlPoints->size() > 0 && !_rational) 
+	{
+		ForwardDifferences(x, y, segments, outX, outY);
+		return;
+	}
 
-	// Get the number of control points
-	int nControlPoints = _controlPoints->size();
+	// Calculate every curve point with the shared basis matrix of the tessellation
+	SampleRange(x, y, segments, 0, segments + 1, outX, outY);
 
-	// Traverse through the control points
-	for (int i = 0; i < nControlPoints; i += 1)
+	// Keep the basis matrix for moving single control points (see MoveControlPoint)
+	if (_controlPoints->size() > 0) 
 	{
-		// Get the reference to the current points and store a copy of it into the copy vector
-		Point * p = _controlPoints->at(i);
-		copiedPoints->push_back(p->copy());
+		_basis = BernsteinBasis::Get(_controlPoints->size(), x, y, segments);
 	}
-
-	// Return the pointer to the vector with the copy of the control points
-	return copiedPoints;
 }
 
-std::vector<Point*>* BezierCurve::CurvePoints(double x, double y, int segments)
+void BezierCurve::SampleRange(double x, double y, int segments, int first, int last, double * outX, double * outY)
 {
-	// Initialize the vector where the curve points will be stored
-	std::vector<Point *> * curvePoints = new std::vector<Point *>();
+	// Get the number of control points
+	int nPoints = _controlPoints->size();
 
-	// Find the parameter step
-	double tStep = (y - x) / (double)segments;
+	// If no control points yet then the origin is every curve point
+	if (nPoints == 0) 
+	{
+		for (int j = first; j < last; j += 1) 
+		{
+			outX[j] = 0.0;
+			outY[j] = 0.0;
+		}
+		return;
+	}
 
-	// Get the points and store them in the curve points vector
-	for (double t = x; t <= y; t += tStep) 
+	// Load the X and Y coordinates of the control points one after the other (and the weights for rational curves)
+	static thread_local std::vector<double> coordinates;
+	coordinates.resize(3 * nPoints);
+	for (int i = 0; i < nPoints; i += 1) 
 	{
-		// Get the points at the given t value and copy it into the curve points vector
-		Point * p = PointAt(t);
-		curvePoints->push_back(p);
+		double weight = _rational ? _controlPoints->_w[i] : 1.0;
+		coordinates[i] = weight * _controlPoints->_x[i];
+		coordinates[nPoints + i] = weight * _controlPoints->_y[i];
+		coordinates[(2 * nPoints) + i] = weight;
 	}
 
-	// Return the pointer to the vector with the curve points
-	return curvePoints;
-}
+	// The weights of the curve points of rational curves
+	static thread_local std::vector<double> weights;
+	weights.resize(segments + 1);
 
-void BezierCurve::DeleteControlPoint(int index)
-{
-	// Delete the control point at the given location
-	delete _controlPoints->at(index);
+	// Multiply the rows of the shared basis matrix of the tessellation by the control points
+	// NOTE: The matrix is not stored in the curve, so several threads can calculate different ranges of the same curve
+	double * out[3] = { outX, outY, weights.data() };
+	std::shared_ptr<const BernsteinBasis> basis = BernsteinBasis::Get(nPoints, x, y, segments);
+	basis->Multiply(coordinates.data(), _rational ? 3 : 2, out, first, last);
 
-	// Erase the given location from the control points vector
-	_controlPoints->erase(_controlPoints->begin() + index);
+	// Project the curve points of rational curves back from homogeneous coordinates
+	if (_rational) 
+	{
+		ProjectHomogeneous(outX + first, outY + first, weights.data() + first, last - first);
+	}
 }
 
-void BezierCurve::Draw(const glm::mat4 model, const glm::mat4 view, const glm::mat4 projection, bool drawControlPoints)
+void BezierCurve::SetControlPoint(int index, double x, double y)
 {
-	// If there are more than 1 control points then draw the elements of the curve
-	if (_controlPoints->size() > 1) 
-	{
-		// Draw the convex hull
-		_drawableConvexHull->Draw(model, view, projection);
-
-		// Draw the polygon lines
-		_drawablePolygonLines->Draw(model, view, projection);
-
-		// Draw the DeCasteljau lines
-		_drawableDeCasteljauLines->Draw(model, view, projection);
+	// Check if the grid and the convex hull match the control points before moving the point
+	bool gridUpToDate = _controlPointGrid && _controlPointGridVersion == _version;
+	bool hullUpToDate = _convexHull && _convexHullVersion == _version;
 
-		// Draw the DeCasteljau points
-		_drawableDeCasteljauPoints->Draw(model, view, projection);
-
-		// Draw the curve lines
-		_drawableCurveLines->Draw(model, view, projection);
-
-		// Draw the curve ticks
-		_drawableCurveTicks->Draw(model, view, projection);
+	// Get the current coordinates of the control point
+	double previousX = _controlPoints->_x[index];
+	double previousY = _controlPoints->_y[index];
 
-		// Draw the curve t point
-		_drawableCurveTPoint->Draw(model, view, projection);
+	// Update the coordinates of the control point
+	_controlPoints->set(index, x, y);
+	_version += 1;
 
-		// Draw the curve s point
-		_drawableCurveSPoint->Draw(model, view, projection);
+	// Update the convex hull with the moved point
+	if (hullUpToDate && _convexHull->Move(_controlPoints, index, previousX, previousY)) 
+	{
+		_convexHullVersion = _version;
 	}
 
-	// Draw if there is at least one control point and it is indicated
-	if (_controlPoints->size() > 0 && drawControlPoints)
+	// Move the stored point in the grid
+	if (gridUpToDate) 
 	{
-		// Draw the control points
-		_drawableControlPoints->Draw(model, view, projection);
+		_controlPointGrid->Move(index, _controlPoints->_x[index], _controlPoints->_y[index]);
+		_controlPointGridVersion = _version;
 	}
 }
 
-void BezierCurve::LowerDegree()
+void BezierCurve::SetRational(bool rational)
 {
-	int nDegrees = _degrees->size();
+	// Set whether the curve is rational and update the version (the curve changes unless every weight is the same)
+	_rational = rational;
+	_version += 1;
+}
 
-	if (nDegrees > 0) 
+bool BezierCurve::SetWeight(int index, double w)
+{
+	// Reject weights that are not positive (the curve would not be defined where the weighted sum vanishes)
+	if (!(w > 0.0) || !std::isfinite(w)) 
 	{
-		Utils::DeletePointVector(_controlPoints);
-
-		_controlPoints = _degrees->at(nDegrees - 1);
-
-		_degrees->erase(_degrees->begin() + (nDegrees - 1));
+		return false;
 	}
+
+	// Set the weight of the control point and update the version
+	_controlPoints->_w[index] = w;
+	_version += 1;
+	return true;
 }
 
-Point * BezierCurve::PointAt(double t)
+std::vector<BezierCurve *> * BezierCurve::SplitAt(const std::vector<double> & ts)
 {
-	// If no control points yet return null
-	if (_controlPoints->size() == 0) 
-	{
-		return NULL;
-	}
+	// Initialize the vector with the pieces
+	std::vector<BezierCurve *> * pieces = new std::vector<BezierCurve *>();
 
-	// Make a copy of the control points
-	std::vector<Point *> * deCasteljauPoints = CopyControlPoints();
+	// Get the number of control points
+	int nPoints = _controlPoints->size();
 
-	// Get the number of DeCasteljau points
-	int nDeCasteljauPoints = deCasteljauPoints->size();
+	// If there are less than two control points then there is nothing to split
+	if (nPoints < 2) 
+	{
+		return pieces;
+	}
 
-	// Repeat while there is more than one point in the DeCasteljau points vector
-	while (nDeCasteljauPoints > 1)
+	// Sort a copy of the parameters
+	static thread_local std::vector<double> sorted;
+	sorted.assign(ts.begin(), ts.end());
+	std::sort(sorted.begin(), sorted.end());
+
+	// Load the control points into the buffer of the remaining curve
+	static thread_local std::vector<double> remaining;
+	remaining.resize(4 * nPoints);
+	double * x = remaining.data();
+	double * y = x + nPoints;
+	double * z = y + nPoints;
+	double * w = z + nPoints;
+	for (int i = 0; i < nPoints; i += 1) 
 	{
-		// Initialize the vector for storing linear interpolation points
-		std::vector<Point *> * lerps = new std::vector<Point *>();
+		x[i] = _controlPoints->_x[i];
+		y[i] = _controlPoints->_y[i];
+		z[i] = _controlPoints->_z[i];
+		w[i] = _controlPoints->_w[i];
 
-		// Traverse through the DeCasteljau points
-		for (int i = 0; i < nDeCasteljauPoints - 1; i += 1)
+		// Rational curves are split in homogeneous coordinates
+		if (_rational) 
 		{
-			// Find the linear interpolation point between the current DeCasteljau point and the next one
-			Point * l = Utils::lerp(deCasteljauPoints->at(i), deCasteljauPoints->at(i + 1), t);
-
-			// Store the new point in the lerps vector
-			lerps->push_back(l);
+			x[i] *= w[i];
+			y[i] *= w[i];
+			z[i] *= w[i];
 		}
+	}
 
-		// Delete the DeCasteljau vector
-		Utils::DeletePointVector(deCasteljauPoints);
+	// Get the number of parameters
+	int nParameters = sorted.size();
+	pieces->reserve(nParameters + 1);
 
-		// Make the lerps vector the new DeCasteljau vector
-		deCasteljauPoints = lerps;
+	// The parameter where the remaining curve starts
+	double a = 0.0;
 
-		// Update the number of DeCasteljau points
-		nDeCasteljauPoints = deCasteljauPoints->size();
-	}
+	// Traverse through the parameters
+	for (int k = 0; k < nParameters; k += 1) 
+	{
+		// Clamp the parameter into the remaining domain [a, 1]
+		double t = sorted[k] < a ? a : (sorted[k] > 1.0 ? 1.0 : sorted[k]);
 
-	// Keep the reference to the remaining point in the DeCasteljau points vector
-	Point * at = deCasteljauPoints->at(0)->copy();
+		// Find the parameter of the cut with respect to the remaining curve
+		double u = (a < 1.0) ? (t - a) / (1.0 - a) : 0.0;
+		double _u = 1.0 - u;
 
-	// Delete the DeCasteljau vector
-	Utils::DeletePointVector(deCasteljauPoints);
+		// Initialize the new piece and insert a copy of the first remaining control point
+		BezierCurve * piece = new BezierCurve();
+		piece->_controlPoints->reserve(nPoints);
+		piece->_controlPoints->push_back(x[0], y[0], z[0], w[0]);
 
-	// Return the pointer of the remaining point
-	return at;
-}
+		// Run the DeCasteljau triangle in place, the first value of every level is a control point of the piece and the
+		// remaining curve ends up holding the part after the cut
+		for (int n = nPoints - 1; n > 0; n -= 1) 
+		{
+			for (int i = 0; i < n; i += 1) 
+			{
+				x[i] = (_u * x[i]) + (u * x[i + 1]);
+				y[i] = (_u * y[i]) + (u * y[i + 1]);
+				z[i] = (_u * z[i]) + (u * z[i + 1]);
+				w[i] = (_u * w[i]) + (u * w[i + 1]);
+			}
 
-void BezierCurve::RaiseDegree()
-{
-	// If there are less than two control points then exit the function
-	if (_controlPoints->size() < 2) 
+			piece->_controlPoints->push_back(x[0], y[0], z[0], w[0]);
+		}
+
+		// Project the control points of rational pieces back from homogeneous coordinates
+		if (_rational) 
+		{
+			piece->_controlPoints->FromHomogeneous();
+			piece->_rational = true;
+		}
+
+		// Store the piece and move the start of the remaining curve
+		pieces->push_back(piece);
+		a = t;
+	}
+
+	// The remaining curve is the last piece
+	BezierCurve * last = new BezierCurve();
+	last->_controlPoints->reserve(nPoints);
+	for (int i = 0; i < nPoints; i += 1) 
 	{
-		return;
+		last->_controlPoints->push_back(x[i], y[i], z[i], w[i]);
+	}
+	if (_rational) 
+	{
+		last->_controlPoints->FromHomogeneous();
+		last->_rational = true;
 	}
+	pieces->push_back(last);
 
-	// Initialize the vector for storing the next degree points
-	std::vector<Point *> * nextDegreePoints = new std::vector<Point *>();
+	// Return the pieces
+	return pieces;
+}
 
-	// Push a copy of the first control point into the next degree points vector
-	nextDegreePoints->push_back(_controlPoints->at(0)->copy());
+std::vector<BezierCurve *> * BezierCurve::SplitUniform(int k)
+{
+	// Initialize the vector with the pieces
+	std::vector<BezierCurve *> * pieces = new std::vector<BezierCurve *>();
 
 	// Get the number of control points
 	int nPoints = _controlPoints->size();
 
-	// Generate the control points for the new degree
-	for (int i = 1; i < nPoints; i += 1) 
+	// If there are less than two control points or no pieces then there is nothing to split
+	if (nPoints < 2 || k < 1) 
 	{
-		// Get the pointer to the required points for calculating the new current one
-		Point * pi_1 = _controlPoints->at(i - 1)->copy();
-		Point * pi = _controlPoints->at(i)->copy();
-
-		// Calculate the common value for both points
-		// NOTE: The actual value is (i / (n + 1)), since nPoints is already (n + 1) then let's use it
-		double val = (double)i / ((double)nPoints);
-
-		// 
-		pi_1->multiply(val);
+		return pieces;
+	}
 
-		// 
-		pi->multiply(1.0 - val);
+	// Get the split matrices for the number of control points and pieces
+	std::shared_ptr<const std::vector<double>> matrices = GetSplitMatrices(nPoints, k);
+	int matrixSize = nPoints * nPoints;
+	pieces->reserve(k);
 
-		// 
-		pi_1->add(pi);
+	// Load the control points into the scratch buffer (rational curves are split in homogeneous coordinates)
+	static thread_local std::vector<double> scratchBuffer;
+	const double * px = LoadWeighted(_controlPoints, _rational, scratchBuffer);
+	const double * py = px + nPoints;
+	const double * pz = py + nPoints;
+	const double * pw = pz + nPoints;
 
-		// Push a copy of the first control point into the next degree points vector
-		nextDegreePoints->push_back(pi_1);
+	// Traverse through the pieces
+	for (int p = 0; p < k; p += 1) 
+	{
+		// Get the matrix of the piece
+		const double * matrix = matrices->data() + (p * matrixSize);
 
-		delete pi;
-	}
+		// Initialize the new piece
+		BezierCurve * piece = new BezierCurve();
+		piece->_controlPoints->reserve(nPoints);
 
-	// Push a copy of the last control point into the next degree points vector
-	nextDegreePoints->push_back(_controlPoints->at(nPoints - 1)->copy());
+		// Calculate every control point of the piece as a weighted sum of the control points of the curve
+		for (int r = 0; r < nPoints; r += 1) 
+		{
+			const double * weights = matrix + (r * nPoints);
+			double x = 0.0;
+			double y = 0.0;
+			double z = 0.0;
+			double w = 0.0;
+			for (int i = 0; i < nPoints; i += 1) 
+			{
+				x += weights[i] * px[i];
+				y += weights[i] * py[i];
+				z += weights[i] * pz[i];
+				w += weights[i] * pw[i];
+			}
+			PushProjected(piece->_controlPoints, _rational, x, y, z, w);
+		}
 
-	// Store the current control points in the degrees vector
-	_degrees->push_back(_controlPoints);
+		// Mark the pieces of rational curves as rational
+		piece->_rational = _rational;
 
-	// Set the new degree points as the control points of the curve
-	_controlPoints = nextDegreePoints;
+		// Store the piece
+		pieces->push_back(piece);
+	}
 
-	// NOTE: It is assumed a curve update is performed after this function
+	// Return the pieces
+	return pieces;
 }
 
 BezierCurve * BezierCurve::Subdivide(double t)
@@ -282,61 +2762,33 @@ BezierCurve * BezierCurve::Subdivide(double t)
 		return NULL;
 	}
 
-	// The vector where the control points for the first half curve will be stored
-	std::vector<Point *> * firstHalf = new std::vector<Point *>();
-
-	// Insert a copy of the first control point into the first half points vector
-	firstHalf->push_back(_controlPoints->at(0)->copy());
-
-	// The vector where the control points for the second half curve will be stored
-	std::vector<Point *> * secondHalf = new std::vector<Point *>();
-
-	// Insert a copy of the last control point into the second half points vector
-	secondHalf->push_back(_controlPoints->at(_controlPoints->size() - 1)->copy());
+	// Get the number of control points
+	int nPoints = _controlPoints->size();
 
-	// Make a copy of the control points
-	std::vector<Point *> * deCasteljauPoints = CopyControlPoints();
+	// The control points for the first half curve
+	ControlPoints * firstHalf = new ControlPoints();
+	firstHalf->reserve(nPoints);
 
-	// Get the number of DeCasteljau points
-	int nDeCasteljauPoints = deCasteljauPoints->size();
+	// The control points for the second half curve
+	ControlPoints * secondHalf = new ControlPoints();
+	secondHalf->reserve(nPoints);
 
-	// Repeat while there is more than one point in the DeCasteljau points vector
-	while (nDeCasteljauPoints > 1)
+	// Use the fixed degree kernel if there is one for the number of control points (rational curves use the generic path, 
+	// which subdivides them in homogeneous coordinates)
+	switch (_rational ? 0 : nPoints) 
 	{
-		// Initialize the vector for storing linear interpolation points
-		std::vector<Point *> * lerps = new std::vector<Point *>();
-
-		// Traverse through the DeCasteljau points
-		for (int i = 0; i < nDeCasteljauPoints - 1; i += 1)
-		{
-			// Find the linear interpolation point between the current DeCasteljau point and the next one
-			Point * l = Utils::lerp(deCasteljauPoints->at(i), deCasteljauPoints->at(i + 1), t);
-
-			// Store the new point in the lerps vector
-			lerps->push_back(l);
-		}
-
-		// Push a copy of the first point in lerps to the first half vector
-		firstHalf->push_back(lerps->at(0)->copy());
-
-		// Push a copy of the last point in lerps to the second half vector
-		secondHalf->push_back(lerps->at(lerps->size() - 1)->copy());
-
-		// Delete the DeCasteljau vector
-		Utils::DeletePointVector(deCasteljauPoints);
-
-		// Make the lerps vector the new DeCasteljau vector
-		deCasteljauPoints = lerps;
-
-		// Update the number of DeCasteljau points
-		nDeCasteljauPoints = deCasteljauPoints->size();
+	case 2: SubdivideFixed<2>(_controlPoints, t, firstHalf, secondHalf); break;
+	case 3: SubdivideFixed<3>(_controlPoints, t, firstHalf, secondHalf); break;
+	case 4: SubdivideFixed<4>(_controlPoints, t, firstHalf, secondHalf); break;
+	case 5: SubdivideFixed<5>(_controlPoints, t, firstHalf, secondHalf); break;
+	case 6: SubdivideFixed<6>(_controlPoints, t, firstHalf, secondHalf); break;
+	case 7: SubdivideFixed<7>(_controlPoints, t, firstHalf, secondHalf); break;
+	case 8: SubdivideFixed<8>(_controlPoints, t, firstHalf, secondHalf); break;
+	default: SubdivideGeneric(_controlPoints, _rational, t, firstHalf, secondHalf); break;
 	}
 
-	// Delete the DeCasteljau vector
-	Utils::DeletePointVector(deCasteljauPoints);
-
 	// Delete the control points
-	Utils::DeletePointVector(_controlPoints);
+	delete _controlPoints;
 
 	// Get the number of stored degrees
 	int nDegrees = _degrees->size();
@@ -344,17 +2796,15 @@ BezierCurve * BezierCurve::Subdivide(double t)
 	// Traverse the degrees and delete them
 	for (int i = 0; i < nDegrees; i += 1)
 	{
-		Utils::DeletePointVector(_degrees->at(i));
+		delete _degrees->at(i);
 	}
 
-	// Delete the degrees vector
-	delete _degrees;
+	// Remove the deleted degrees from the vector
+	_degrees->clear();
 
 	// Set the first half as the new control points
 	_controlPoints = firstHalf;
-
-	// Initialize the degrees vector
-	_degrees = new std::vector<std::vector<Point *> *>();
+	_version += 1;
 
 	// Initialize a new Bezier curve
 	BezierCurve * newHalfCurve = new BezierCurve();
@@ -362,22 +2812,49 @@ BezierCurve * BezierCurve::Subdivide(double t)
 	// Delete the control points of the new bezier curve and set the second half points as control points
 	delete newHalfCurve->_controlPoints;
 	newHalfCurve->_controlPoints = secondHalf;
+	newHalfCurve->_rational = _rational;
 
 	// Return the new half bezier curve
 	return newHalfCurve;
 }
 
-void BezierCurve::Update(double x, double y, int segments)
+void BezierCurve::Tessellate(double x, double y, int segments)
 {
-	// If there is at least one control point then redefine the control points geometry
-	if (_controlPoints->size() > 0) 
+	// If there are less than two control points then exit the function
+	if (_controlPoints->size() < 2) 
 	{
-		// Redefine the geometry of the control points
-		_drawableControlPoints->DefineGeometry(_controlPoints);
+		return;
 	}
 
-	// If there are less than two control points then exit the function
-	if (_controlPoints->size() < 2) 
+	// If the adaptive tessellation is used then the curve decides its number of points, otherwise calculate the segments + 1 curve points
+	if (_tessellationMode == TESSELLATION_ADAPTIVE) 
+	{
+		AdaptiveTessellation(x, y, _flatnessTolerance, _curveX, _curveY);
+	}
+	else 
+	{
+		_curveX.resize(segments + 1);
+		_curveY.resize(segments + 1);
+		Sample(x, y, segments, _curveX.data(), _curveY.data());
+	}
+
+	// Indicate the curve points match the current control points
+	_curveVersion = _version;
+}
+
+void BezierCurve::Update(double x, double y, int segments)
+{
+	// Calculate the curve points
+	Tessellate(x, y, segments);
+
+	// Update the geometry of the drawable elements
+	UpdateGeometry(x, y);
+}
+
+void BezierCurve::UpdateCurveLines(double x, double y)
+{
+	// If there are less than two control points or no curve points then exit the function
+	if (_controlPoints->size() < 2 || _curveX.size() == 0) 
 	{
 		return;
 	}
@@ -386,26 +2863,24 @@ void BezierCurve::Update(double x, double y, int segments)
 	_lastX = (double)x;
 	_lastY = (double)y;
 
-	// Redefine the geometry of the control polygon
-	_drawablePolygonLines->DefineSequenceGeometry(_controlPoints);
+	// Get the number of curve points
+	int nCurvePoints = _curveX.size();
+
+	// Initialize the vector with the curve points
+	std::vector<Point *> * curvePoints = new std::vector<Point *>();
+	curvePoints->reserve(nCurvePoints);
 
-	// Get the curve points
-	std::vector<Point *> * curvePoints = CurvePoints(x, y, segments);
+	// Store the curve points
+	for (int j = 0; j < nCurvePoints; j += 1) 
+	{
+		curvePoints->push_back(new Point(_curveX[j], _curveY[j]));
+	}
 
 	// Redefine the geometry of the curve lines
 	_drawableCurveLines->DefineSequenceGeometry(curvePoints);
 
-	// Sort the control points and calculate the convex hull
-	std::vector<Point *> * controlPointsCopy = CopyControlPoints();
-	std::vector<Point *> * convexHullVertices = Utils::ConvexHull(controlPointsCopy);
-
-	// Define the convex hull geometry
-	_drawableConvexHull->DefineGeometry(convexHullVertices);
-
-	// Delete vectors
+	// Delete the vector
 	Utils::DeletePointVector(curvePoints);
-	Utils::DeletePointVector(controlPointsCopy);
-	Utils::DeletePointVector(convexHullVertices);
 }
 
 void BezierCurve::UpdateDeCasteljau(double t)
@@ -425,6 +2900,16 @@ void BezierCurve::UpdateDeCasteljau(double t)
 	// Get the number of copy points
 	int nCopyPoints = copyPoints->size();
 
+	// The DeCasteljau lines of rational curves are calculated in homogeneous coordinates
+	if (_rational) 
+	{
+		for (int i = 0; i < nCopyPoints; i += 1) 
+		{
+			Point * p = copyPoints->at(i);
+			p->set(p->x * p->w, p->y * p->w, p->z * p->w, p->w);
+		}
+	}
+
 	// Initialize the vector where the DeCasteljau pair points are stored
 	// NOTE: These are the points representing the DeCasteljau lines
 	std::vector<Point *> * deCasteljauPairPoints = new std::vector<Point *>();
@@ -491,6 +2976,14 @@ void BezierCurve::UpdateDeCasteljau(double t)
 		nCopyPoints = copyPoints->size();
 	}
 
+	// Project the points of rational curves back from homogeneous coordinates
+	if (_rational) 
+	{
+		ProjectPointVector(deCasteljauPairPoints);
+		ProjectPointVector(deCasteljauPoints);
+		ProjectPointVector(copyPoints);
+	}
+
 	// Define the geometry of the DeCasteljau lines using the stored points so far
 	_drawableDeCasteljauLines->DefinePairsGeometry(deCasteljauPairPoints);
 
@@ -513,64 +3006,100 @@ void BezierCurve::UpdateDeCasteljau(double t)
 	Utils::DeletePointVector(tCurvePoint);
 }
 
-void BezierCurve::UpdateSPoint(double s, double l, double r)
+void BezierCurve::UpdateGeometry(double x, double y)
 {
-	// Update the last s reparametrized parameter
-	_lastS = s;
+	// Make a copy of the control points as a vector of points for the drawables
+	std::vector<Point *> * controlPointsCopy = CopyControlPoints();
 
-	// Update the last left reparametrized domain
-	_lastSLeft = l;
+	// If there is at least one control point then redefine the control points geometry
+	if (_controlPoints->size() > 0) 
+	{
+		// Redefine the geometry of the control points
+		_drawableControlPoints->DefineGeometry(controlPointsCopy);
+	}
 
-	// Update the last right reparametrized domain
-	_lastSRight = r;
+	// If there are less than two control points then exit the function
+	if (_controlPoints->size() < 2) 
+	{
+		Utils::DeletePointVector(controlPointsCopy);
+		return;
+	}
 
-	// Calculate the equivalent t value for the repatametrized domain
-	double t = ((-l) / (r - l)) + (((1.0) / (r - l)) * s);
+	// Redefine the geometry of the control polygon
+	_drawablePolygonLines->DefineSequenceGeometry(controlPointsCopy);
 
-	// Get the point for the calculated t
-	Point * p = PointAt(t);
+	// Redefine the geometry of the curve lines
+	UpdateCurveLines(x, y);
+
+	// Get the vertices of the convex hull (only the hull vertices are copied)
+	const std::vector<int> & convexHull = ConvexHull();
+	int nConvexHull = convexHull.size();
+	std::vector<Point *> * convexHullVertices = new std::vector<Point *>();
+	convexHullVertices->reserve(nConvexHull);
+	for (int i = 0; i < nConvexHull; i += 1) 
+	{
+		convexHullVertices->push_back(new Point(_controlPoints->at(convexHull[i])));
+	}
+
+	// Define the convex hull geometry
+	_drawableConvexHull->DefineGeometry(convexHullVertices);
+
+	// Delete vectors
+	Utils::DeletePointVector(controlPointsCopy);
+	Utils::DeletePointVector(convexHullVertices);
+}
+
+void BezierCurve::UpdateSPoint(double s, double l, double r)
+{
+	// Calculate the reparametrized point and redefine its geometry
+	ComputeSPoint(s, l, r);
+	UploadSPoint();
+}
+
+void BezierCurve::UpdateTicks(int n, bool arcLength)
+{
+	// If no ticks are to be drawn then exit the function
+	if (_controlPoints->size() < 1 || n < 1) 
+	{
+		return;
+	}
+
+	// Calculate the ticks and redefine their geometry
+	ComputeTicks(n, arcLength);
+	UploadTicks();
+}
 
+void BezierCurve::UploadSPoint()
+{
 	// Initialize a vector for storing the point
 	std::vector<Point *> * sPoint = new std::vector<Point *>();
 
-	// Insert the point into the vector
-	sPoint->push_back(p->copy());
+	// Insert the last calculated point into the vector
+	sPoint->push_back(new Point(_sPoint));
 
 	// Redefine the geometry of the reparametrized point
 	_drawableCurveSPoint->DefineGeometry(sPoint);
 
-	// Delete the calculated point
-	delete p;
-
 	// Delete the vector
 	Utils::DeletePointVector(sPoint);
 }
 
-void BezierCurve::UpdateTicks(int n)
+void BezierCurve::UploadTicks()
 {
-	// If no ticks are to be drawn then exit the function
-	if (_controlPoints->size() < 1 || n < 1) 
+	// If no ticks have been calculated then exit the function
+	int nTicks = _tickX.size();
+	if (nTicks == 0) 
 	{
 		return;
 	}
 
-	// Store the number of generated ticks
-	_nTicks = n;
-
 	// Initialize the vector where the tick points will be stored
 	std::vector<Point *> * ticks = new std::vector<Point *>();
 
-	// Traverse through the ticks and generate them
-	for (int i = 0; i <= n; i += 1) 
+	// Traverse through the ticks and push them into the ticks vector
+	for (int i = 0; i < nTicks; i += 1) 
 	{
-		// Calculate the parameter value for the current tick
-		double t = (double)i / (double)n;
-
-		// Get the point for the current tick
-		Point * p = PointAt(t);
-
-		// Push the point into the ticks vector
-		ticks->push_back(p);
+		ticks->push_back(new Point(_tickX[i], _tickY[i]));
 	}
 
 	// Define the geometry for the curve ticks
@@ -3,9 +3,95 @@
 #ifndef _BEZIER_CURVE_H_
 #define _BEZIER_CURVE_H_
 
+#include "bernstein_basis.h"
+#include "control_point_grid.h"
+#include "control_points.h"
 #include "drawable_lines.h"
 #include "drawable_points.h"
 #include "drawable_polygon.h"
+#include "incremental_hull.h"
+
+// The maximum number of control points evaluated using stack storage
+const int BEZIER_STACK_POINTS = 32;
+
+// The default number of forward difference steps between two exact evaluations
+const int FORWARD_DIFFERENCES_RESEED = 16;
+
+// The maximum number of times a curve is split in half by the adaptive tessellation
+const int ADAPTIVE_MAX_DEPTH = 16;
+
+// The default flatness tolerance of the adaptive tessellation (half a pixel on a 900 pixels wide [-1, 1] view)
+const double ADAPTIVE_FLATNESS_TOLERANCE = 1.0 / 900.0;
+
+// The number of intervals of the arc length table (the lengths are stored at t = i / ARC_LENGTH_INTERVALS)
+const int ARC_LENGTH_INTERVALS = 64;
+
+// The maximum number of Newton iterations when finding the parameter at a given arc length
+const int ARC_LENGTH_MAX_ITERATIONS = 16;
+
+// The parametric tolerance of the extremes of the curve coordinates used by the bounding box
+const double BOUNDING_BOX_TOLERANCE = 1e-10;
+
+// The parametric tolerance of the closest points
+const double CLOSEST_POINT_TOLERANCE = 1e-12;
+
+// The methods for calculating the curve points
+enum TessellationMode
+{
+	// Every curve point is evaluated using DeCasteljau's algorithm
+	TESSELLATION_DECASTELJAU = 0,
+
+	// Curve points are generated by adding forward differences
+	TESSELLATION_FORWARD_DIFFERENCES = 1, 
+
+	// The curve is split in half until its control polygons are flat, so the number of curve points depends on its shape
+	TESSELLATION_ADAPTIVE = 2
+};
+
+/*
+The differential values of a curve at many parameters, one array per value (index k holds the values at the k-th parameter).
+*/
+struct CurveFrames
+{
+	// The X coordinates of the curve points
+	std::vector<double> _x;
+
+	// The Y coordinates of the curve points
+	std::vector<double> _y;
+
+	// The X coordinates of the unit tangents
+	std::vector<double> _tangentX;
+
+	// The Y coordinates of the unit tangents
+	std::vector<double> _tangentY;
+
+	// The X coordinates of the unit normals (the tangents rotated 90 degrees counterclockwise)
+	std::vector<double> _normalX;
+
+	// The Y coordinates of the unit normals
+	std::vector<double> _normalY;
+
+	// The signed curvatures (positive when the curve turns counterclockwise)
+	std::vector<double> _curvature;
+};
+
+/*
+The closest point of a curve to a query point.
+*/
+struct CurveProjection
+{
+	// The parameter of the closest point
+	double _t;
+
+	// The X coordinate of the closest point
+	double _x;
+
+	// The Y coordinate of the closest point
+	double _y;
+
+	// The distance between the query point and the closest point
+	double _distance;
+};
 
 /*
 The class representing the Bezier Curve
@@ -15,11 +101,11 @@ class BezierCurve
 
 public:
 
-	// The vector where control points are stored
-	std::vector<Point *> * _controlPoints;
+	// The control points of the curve
+	ControlPoints * _controlPoints;
 
-	// The vector containing the increased point degrees of the curve
-	std::vector<std::vector<Point *> *> * _degrees;
+	// The vector containing the control points of the previous degrees of the curve
+	std::vector<ControlPoints *> * _degrees;
 
 	// The drawable lines representing the curve
 	DrawableLines * _drawableCurveLines;
@@ -69,9 +155,88 @@ public:
 	// The number of ticks defined for the curve
 	int _nTicks;
 
+	// Indicates whether the ticks are placed at equal arc lengths instead of equal parameter steps
+	bool _arcLengthTicks;
+
+	// The X coordinates of the last calculated ticks
+	std::vector<double> _tickX;
+
+	// The Y coordinates of the last calculated ticks
+	std::vector<double> _tickY;
+
+	// The last calculated reparametrized point
+	Point _sPoint;
+
 	// Indicate the las
 	int _updatedControlPoints;
 
+	// The X coordinates of the last calculated curve points
+	std::vector<double> _curveX;
+
+	// The Y coordinates of the last calculated curve points
+	std::vector<double> _curveY;
+
+	// The method used for calculating the curve points
+	TessellationMode _tessellationMode;
+
+	// The number of forward difference steps before the differences are seeded again with exact values
+	int _reseedInterval;
+
+	// The maximum distance between the curve and its lines when using the adaptive tessellation
+	double _flatnessTolerance;
+
+	// The version of the control points, it increases every time they change
+	int _version;
+
+	// The version of the control points used for calculating the curve points (_curveX and _curveY)
+	int _curveVersion;
+
+	// The Bernstein basis matrix of the current curve points, used for moving control points
+	std::shared_ptr<const BernsteinBasis> _basis;
+
+	// Indicates whether the curve is rational, this is, whether the W coordinates of the control points are used as weights
+	// NOTE: Weights must be positive
+	bool _rational;
+
+	// The control points of the first derivative of the curve (see Hodograph)
+	ControlPoints * _firstHodograph;
+
+	// The control points of the second derivative of the curve (see Hodograph)
+	ControlPoints * _secondHodograph;
+
+	// The version of the control points used for calculating the hodographs
+	int _hodographVersion;
+
+	// The arc length table, the length of the curve from t = 0 to t = i / ARC_LENGTH_INTERVALS for every i
+	std::vector<double> _arcLengths;
+
+	// The version of the control points used for calculating the arc length table
+	int _arcLengthVersion;
+
+	// The products of the curve and its hodograph used by the closest point queries (see ProjectionProducts)
+	std::vector<double> _projectionProducts;
+
+	// The version of the control points used for calculating the projection products
+	int _projectionVersion;
+
+	// The bounding box of the curve (minimum X, minimum Y, maximum X, maximum Y, see BoundingBox)
+	double _boundingBox[4];
+
+	// The version of the control points used for calculating the bounding box
+	int _boundingBoxVersion;
+
+	// The hash grid over the control points used for finding the control point at a position (see FindControlPoint)
+	ControlPointGrid * _controlPointGrid;
+
+	// The version of the control points stored in the grid
+	int _controlPointGridVersion;
+
+	// The convex hull of the control points (see ConvexHull)
+	IncrementalHull * _convexHull;
+
+	// The version of the control points of the convex hull
+	int _convexHullVersion;
+
 
 	/*
 	Constructor of the class
@@ -83,6 +248,19 @@ public:
 	*/
 	~BezierCurve();
 
+	/*
+	Calculates the curve points in the domain [x, y] splitting the curve in half (DeCasteljau at t = 0.5) until the control 
+	polygon of every part is within the given distance from its chord, or ADAPTIVE_MAX_DEPTH splits are reached. Only the 
+	first point and the last control point of every flat part are stored, so nearly straight curves cost two points.
+	NOTE: The curve lies in the convex hull of its control points, so every flat part is within the tolerance from its line.
+	@param double x The left value of the parameter domain
+	@param double y The right value of the parameter domain
+	@param double tolerance The maximum distance between the curve and its lines
+	@param std::vector<double> & outX The vector where the X coordinates are stored
+	@param std::vector<double> & outY The vector where the Y coordinates are stored
+	*/
+	void AdaptiveTessellation(double x, double y, double tolerance, std::vector<double> & outX, std::vector<double> & outY);
+
 	/*
 	Adds a new control point with the given coordinates to the control points vector
 	@param double x The X coordinate of the point
@@ -90,11 +268,85 @@ public:
 	*/
 	void AddControlPoint(double x, double y);
 
+	/*
+	Calculates the arc length table of the curve if the control points changed since it was calculated. The length of every 
+	interval is the integral of the speed of the curve (the length of the first derivative) using Gauss-Legendre quadrature.
+	*/
+	void ArcLengthTable();
+
+	/*
+	Returns the tight bounding box of the curve. The extremes of every coordinate are at the ends of the curve or at the roots 
+	of its derivative, which are isolated from the first hodograph (X' W - X W' for rational curves) using Utils::BernsteinRoots. 
+	The box is calculated again only if the control points changed since it was calculated.
+	NOTE: If the curve has no control points then the box is the origin.
+	@param double box[4] The array where the box is stored (minimum X, minimum Y, maximum X, maximum Y)
+	*/
+	void BoundingBox(double box[4]);
+
 	/*
 	Clears all of the content of the Bezier curve
 	*/
 	void Clear();
 
+	/*
+	Returns the closest point of the curve to the given point. The closest point is either an end of the curve or a root of 
+	(P(t) - q) . P'(t), a polynomial of degree 2n - 1 whose Bernstein coefficients are A - qx Bx - qy By, with A, Bx and By 
+	the cached projection products. Its roots are isolated using Utils::BernsteinRoots.
+	NOTE: If the curve has no control points then the origin is returned.
+	@param Point q The query point
+	@return CurveProjection The closest point, its parameter and its distance to the query point
+	*/
+	CurveProjection ClosestPoint(Point q);
+
+	/*
+	Returns the closest points of the curve to many query points (see ClosestPoint). The projection products are calculated 
+	once, so every query only builds its coefficients and isolates their roots.
+	@param const double * x The X coordinates of the query points
+	@param const double * y The Y coordinates of the query points
+	@param size_t n The number of query points
+	@param CurveProjection * out The array where the closest points are stored (n values)
+	*/
+	void ClosestPoints(const double * x, const double * y, size_t n, CurveProjection * out);
+
+	/*
+	Calculates the curve point with reparametrized domain [l, r] and stores it in _sPoint. The drawable point is not updated
+	(see UploadSPoint), so it can be called outside of the thread owning the OpenGL context.
+	@param double s The reparametrized parameter
+	@param double l The left boundary of the reparametrized domain
+	@param double r The right boundary for the reparametrized domain
+	*/
+	void ComputeSPoint(double s, double l, double r);
+
+	/*
+	Calculates the ticks of the curve and stores them in _tickX and _tickY. The drawable points are not updated (see UploadTicks),
+	so it can be called outside of the thread owning the OpenGL context.
+	@param int n The number of ticks
+	@param bool arcLength If the ticks are placed at equal arc lengths instead of equal parameter steps
+	*/
+	void ComputeTicks(int n, bool arcLength);
+
+	/*
+	Returns the control point stored at the given index.
+	@param int index The index of the control point
+	@return Point The control point
+	*/
+	Point ControlPointAt(int index);
+
+	/*
+	Returns the bounding box of the control points. It is cheaper than BoundingBox but looser, and it contains the curve as long 
+	as the weights are positive.
+	NOTE: If the curve has no control points then the box is the origin.
+	@param double box[4] The array where the box is stored (minimum X, minimum Y, maximum X, maximum Y)
+	*/
+	void ControlPolygonBox(double box[4]);
+
+	/*
+	Returns the convex hull of the control points. The hull is kept up to date by AddControlPoint, DeleteControlPoint and 
+	SetControlPoint (see IncrementalHull), and it is calculated again if the control points changed in any other way.
+	@return const std::vector<int> & The indices of the vertices of the hull in counterclockwise order
+	*/
+	const std::vector<int> & ConvexHull();
+
 	/*
 	Returns a pointer to the vector with the copy of the control points.
 	@return std::vector<Point *> * A pointer to the vector with the copy of the control points
@@ -102,7 +354,8 @@ public:
 	std::vector<Point *> * CopyControlPoints();
 
 	/*
-	Returns a vector with the points of the Bezier Curve in the domain [x, y]
+	Returns a vector with the points of the Bezier Curve in the domain [x, y]. Points are calculated using the current tessellation mode.
+	NOTE: There are always segments + 1 points, the first and the last ones at parameters x and y respectively.
 	@param double x The left value of the parameter domain
 	@param double y The right value of the parameter domain
 	@param int segments The number of segments of the curve
@@ -126,10 +379,120 @@ public:
 	void Draw(const glm::mat4 model, const glm::mat4 view, const glm::mat4 projection, bool drawControlPoints);
 
 	/*
-	Lowers the degree of the curve to the latest stored.
+	Returns the curve point at parameter t. Point is obtained running DeCasteljau's algorithm in place over a single 
+	scratch buffer of plain values (stack storage for up to BEZIER_STACK_POINTS control points), so no point is allocated.
+	NOTE: If the curve has no control points then the point (0, 0, 0) is returned.
+	NOTE: Rational curves run the algorithm over the weighted control points and their weights, then divide by the weight.
+	@param double t The parameter for the point
+	@return Point The point at the given parameter
+	*/
+	Point Evaluate(double t);
+
+	/*
+	Calculates the curve points, unit tangents, unit normals and curvatures at many parameters in a single pass of DeCasteljau's 
+	algorithm per parameter. The three points of the third to last level give the second derivative (n (n - 1) (Q0 - 2 Q1 + Q2)) 
+	and the two points of the second to last level give the first derivative (n (R1 - R0)), so no extra evaluation is needed.
+	NOTE: Rational curves run the algorithm in homogeneous coordinates and apply the quotient rule to the derivatives.
+	NOTE: Where the first derivative vanishes the tangent, the normal and the curvature are zero.
+	NOTE: Polynomial curves with up to FIXED_BEZIER_MAX_POINTS control points evaluate their fixed degree curve and its
+	derivatives instead (see FixedBezier::Derivative).
+	@param const double * t The array with the parameters
+	@param size_t n The number of parameters
+	@param CurveFrames & frames The frames where the values are stored (every array is resized to n values)
+	*/
+	void EvaluateFrames(const double * t, size_t n, CurveFrames & frames);
+
+	/*
+	Calculates the parameters splitting the curve into n parts of the same arc length.
+	@param int n The number of parts
+	@param double * outT The array where the parameters are stored (n + 1 values, from 0 to 1)
+	*/
+	void EqualArcLengthParameters(int n, double * outT);
+
+	/*
+	Evaluates the curve at many parameters at once. DeCasteljau's algorithm runs over several parameters per instruction
+	(4 with AVX, 2 with SSE2, 1 otherwise).
+	NOTE: If the curve has no control points then the origin is returned for every parameter.
+	NOTE: Rational curves also run the algorithm over the weights and divide the curve points by them.
+	@param const double * t The array with the parameters
+	@param size_t n The number of parameters
+	@param double * outX The array where the X coordinates are stored (n values)
+	@param double * outY The array where the Y coordinates are stored (n values)
+	*/
+	void EvaluateMany(const double * t, size_t n, double * outX, double * outY);
+
+	/*
+	Returns the first control point whose square (centered at the control point) contains the given position. The control points
+	are stored in a hash grid with cells as wide as the squares, so only the control points of the cells around the position are 
+	checked. The grid is kept up to date by AddControlPoint, DeleteControlPoint and SetControlPoint, and it is built again if 
+	the square size changes or the control points changed in any other way.
+	@param double x The X coordinate of the position
+	@param double y The Y coordinate of the position
+	@param double halfSize The half of the length of the sides of the squares
+	@return int The index of the control point, or -1 if the position is not within any control point square
+	*/
+	int FindControlPoint(double x, double y, double halfSize);
+
+	/*
+	Calculates the X and Y coordinates of the segments + 1 curve points in the domain [x, y] using forward differences. Differences
+	are obtained from the control points using cached matrices (one per seed) and seeded again with exact values every _reseedInterval
+	steps and at the last point, so rounding errors do not accumulate on high degree curves.
+	@param double x The left value of the parameter domain
+	@param double y The right value of the parameter domain
+	@param int segments The number of segments of the curve
+	@param double * outX The array where the X coordinates are stored (segments + 1 values)
+	@param double * outY The array where the Y coordinates are stored (segments + 1 values)
+	*/
+	void ForwardDifferences(double x, double y, int segments, double * outX, double * outY);
+
+	/*
+	Returns the control points of the first or the second derivative of the curve. They are calculated again only when the 
+	control points change (n (P_i+1 - P_i) for the first derivative, applied twice for the second one).
+	NOTE: Rational curves return the hodographs of the curve in homogeneous coordinates: X and Y hold the derivatives of the 
+	weighted coordinates and W the derivatives of the weights. Polynomial curves have W equal to zero, and the ones with up to
+	FIXED_BEZIER_MAX_POINTS control points use their fixed degree kernel (see FixedBezier::Derivative).
+	@param int order The order of the derivative (1 or 2)
+	@return const ControlPoints * The pointer to the control points of the derivative (NULL for any other order)
+	*/
+	const ControlPoints * Hodograph(int order);
+
+	/*
+	Returns the arc length of the curve from t = 0 to the given parameter. The length up to the closest table entry is taken 
+	from the arc length table and the rest is integrated using Gauss-Legendre quadrature.
+	NOTE: The parameter is clamped to [0, 1].
+	@param double t The parameter
+	@return double The arc length from t = 0 to t
+	*/
+	double LengthAt(double t);
+
+	/*
+	Lowers the degree of the curve to the latest stored. If there is no stored degree then the degree is reduced by one using ReduceDegree.
 	*/
 	void LowerDegree();
 
+	/*
+	Moves the control point stored at the given index. Since every curve point depends linearly on the control points, moving 
+	control point i by (dx, dy) moves the curve point at t by (dx, dy) * B_i(t), so the curve points are updated with a single 
+	AXPY using the column of the control point in the Bernstein basis matrix of the curve points.
+	NOTE: The curve points are only updated if they were calculated with the current control points and not using the adaptive 
+	tessellation, otherwise false is returned and the curve must be updated.
+	@param int index The index of the control point
+	@param double x The new X coordinate of the point
+	@param double y The new Y coordinate of the point
+	@return bool If the curve points were updated
+	*/
+	bool MoveControlPoint(int index, double x, double y);
+
+	/*
+	Returns the parameter where the arc length of the curve from t = 0 is the given length. The interval of the arc length 
+	table containing the length gives the bracket and the first guess (interpolating linearly), then Newton's iteration refines 
+	it using the speed of the curve as the derivative of the length (bisecting whenever a step leaves the bracket).
+	NOTE: The length is clamped to [0, length of the curve].
+	@param double s The arc length
+	@return double The parameter at the given arc length
+	*/
+	double ParamAtLength(double s);
+
 	/*
 	Returns the curve point at parameter t. Point is obtained using DeCasteljau's algorithm
 	@param double t The parameter for the point
@@ -137,12 +500,106 @@ public:
 	*/
 	Point * PointAt(double t);
 
+	/*
+	Calculates the products of the curve and its hodograph used by the closest point queries if the control points changed since 
+	they were calculated. For a polynomial curve X with hodograph G they are A = X . G, Bx = Gx and By = Gy (elevated to the 
+	degree of A), so (X(t) - q) . G(t) = A - qx Bx - qy By. Rational curves X / W use G = X' W - X W', Bx = W Gx and By = W Gy 
+	instead (the closest point condition multiplied by W^3).
+	*/
+	void ProjectionProducts();
+
 	/*
 	Raises the curve degree by one. Algorithm detailed in 
 	http://pages.mtu.edu/~shene/COURSES/cs3621/NOTES/spline/Bezier/bezier-elev.html
 	*/
 	void RaiseDegree();
 
+	/*
+	Raises the curve degree r times in a single pass. Every new control point is a combination of the control points in a band
+	of r + 1 of them, with coefficients C(n, i) C(r, j - i) / C(n + r, j) cached per number of control points and r.
+	NOTE: The previous control points are stored as a single degree, so LowerDegree undoes the r steps at once.
+	@param int r The number of degrees to raise
+	*/
+	void RaiseDegreeBy(int r);
+
+	/*
+	Reduces the degree of the curve so it has m control points. Both end points are kept and the inner control points are the 
+	constrained least squares fit whose elevation back to the original degree is closest to the original control points. The fit 
+	is a single product with a reduction matrix cached per number of control points and m.
+	NOTE: The stored degrees are deleted, since they no longer describe the same curve. Rational curves are not reduced, since the
+	fitted weights may not be positive and the bound of their weighted control points does not bound the projected curves.
+	@param int m The number of control points of the reduced curve (2 <= m < number of control points)
+	@return double The bound of the distance between the original and the reduced curves (0 if the curve is not reduced)
+	*/
+	double ReduceDegree(int m);
+
+	/*
+	Calculates the X and Y coordinates of the segments + 1 curve points in the domain [x, y] using the current tessellation mode.
+	NOTE: With DeCasteljau's algorithm the points are the product of the shared Bernstein basis matrix and the control points.
+	NOTE: The adaptive tessellation does not produce a fixed number of points, so curves using it are sampled with DeCasteljau's algorithm.
+	NOTE: Rational curves always use the basis matrix, multiplying it by the weighted control points and the weights.
+	@param double x The left value of the parameter domain
+	@param double y The right value of the parameter domain
+	@param int segments The number of segments of the curve
+	@param double * outX The array where the X coordinates are stored (segments + 1 values)
+	@param double * outY The array where the Y coordinates are stored (segments + 1 values)
+	*/
+	void Sample(double x, double y, int segments, double * outX, double * outY);
+
+	/*
+	Calculates the curve points [first, last) of the segments + 1 curve points in the domain [x, y] using the shared Bernstein
+	basis matrix of the tessellation, so the points of a single curve can be split among several threads.
+	NOTE: The matrix is not stored in the curve (see Sample), and rational curves are projected back only within the range.
+	@param double x The left value of the parameter domain
+	@param double y The right value of the parameter domain
+	@param int segments The number of segments of the curve
+	@param int first The first curve point to be calculated
+	@param int last The last curve point to be calculated (exclusive)
+	@param double * outX The array where the X coordinates are stored (segments + 1 values, only [first, last) are written)
+	@param double * outY The array where the Y coordinates are stored (segments + 1 values, only [first, last) are written)
+	*/
+	void SampleRange(double x, double y, int segments, int first, int last, double * outX, double * outY);
+
+	/*
+	Sets the coordinates of the control point stored at the given index.
+	@param int index The index of the control point
+	@param double x The X coordinate of the point
+	@param double y The Y coordinate of the point
+	*/
+	void SetControlPoint(int index, double x, double y);
+
+	/*
+	Sets whether the curve is rational, this is, whether the weights of the control points are used.
+	@param bool rational If the curve is rational
+	*/
+	void SetRational(bool rational);
+
+	/*
+	Sets the weight of the control point stored at the given index. Weights only change the curve when it is rational.
+	@param int index The index of the control point
+	@param double w The weight of the point (must be positive and finite)
+	@return bool If the weight was set (false if it is rejected)
+	*/
+	bool SetWeight(int index, double w);
+
+	/*
+	Splits the curve at the given parameters in a single sweep. The parameters are sorted and every cut runs DeCasteljau's algorithm
+	in place over the remaining part of the curve, so no intermediate level is allocated. The curve is not modified.
+	NOTE: Parameters are clamped to [0, 1]. If the curve has less than two control points then the vector is empty.
+	@param const std::vector<double> & ts The cutting parameters
+	@return std::vector<BezierCurve *> * The pointer to the vector with the ts.size() + 1 pieces, in parameter order
+	*/
+	std::vector<BezierCurve *> * SplitAt(const std::vector<double> & ts);
+
+	/*
+	Splits the curve into k pieces of equal parameter length. The control points of every piece are obtained from the control
+	points of the curve using cached split matrices (one per number of control points and pieces). The curve is not modified.
+	NOTE: If the curve has less than two control points or k is less than one then the vector is empty.
+	@param int k The number of pieces
+	@return std::vector<BezierCurve *> * The pointer to the vector with the k pieces, in parameter order
+	*/
+	std::vector<BezierCurve *> * SplitUniform(int k);
+
 	/*
 	Subdivides the current curve into two curves. The current curve keeps the first half (from the first control point to the point at t).
 	The second half (from point at t to the original final control point) is returned.
@@ -152,6 +609,15 @@ public:
 	*/
 	BezierCurve * Subdivide(double t);
 
+	/*
+	Calculates the curve points in the domain [x, y] using the current tessellation mode and stores them in _curveX and _curveY.
+	NOTE: The number of segments is ignored by the adaptive tessellation, which uses _flatnessTolerance instead.
+	@param double x The left value of the parameter domain
+	@param double y The right value of the parameter domain
+	@param int segments The number of segments of the curve
+	*/
+	void Tessellate(double x, double y, int segments);
+
 	/*
 	Updates the geometry of the drawable elements representing the curve (curve and polygon lines).
 	@param double x The left value of the parameter domain
@@ -160,12 +626,27 @@ public:
 	*/
 	void Update(double x, double y, int segments);
 
+	/*
+	Updates the geometry of the curve lines using the stored curve points (_curveX and _curveY).
+	@param double x The left value of the parameter domain used for calculating the curve points
+	@param double y The right value of the parameter domain used for calculating the curve points
+	*/
+	void UpdateCurveLines(double x, double y);
+
 	/*
 	Updates the DeCasteljau lines using the given parameter.
 	@param double t
 	*/
 	void UpdateDeCasteljau(double t);
 
+	/*
+	Updates the geometry of the drawable elements representing the curve using the stored curve points (_curveX and _curveY).
+	NOTE: It is used when the curve points have been calculated elsewhere (e.g. by a BezierBatch).
+	@param double x The left value of the parameter domain used for calculating the curve points
+	@param double y The right value of the parameter domain used for calculating the curve points
+	*/
+	void UpdateGeometry(double x, double y);
+
 	/*
 	Updates the curve point with reparametrized domain [l, r]
 	@param double s The reparametrized parameter
@@ -177,8 +658,19 @@ public:
 	/*
 	Update the number of ticks to be displayed on the curve.
 	@param int n The number of ticks
+	@param bool arcLength If the ticks are placed at equal arc lengths instead of equal parameter steps
+	*/
+	void UpdateTicks(int n, bool arcLength);
+
+	/*
+	Updates the drawable reparametrized point using the last calculated one (see ComputeSPoint).
+	*/
+	void UploadSPoint();
+
+	/*
+	Updates the drawable ticks using the last calculated ones (see ComputeTicks).
 	*/
-	void UpdateTicks(int n);
+	void UploadTicks();
 
 };
 
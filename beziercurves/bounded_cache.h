@@ -0,0 +1,73 @@
+#pragma once
+
+#ifndef _BOUNDED_CACHE_H_
+#define _BOUNDED_CACHE_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+// The default maximum number of values of a cache
+const int BOUNDED_CACHE_SIZE = 64;
+
+/*
+The class representing a thread safe cache of shared immutable values (e.g. the matrices of a tessellation), indexed by the
+values they are built from. Values are built by the caller outside of the lock, and the whole cache is dropped when it is
+full, since its keys usually change together (e.g. dragging the domain generates a new key on every frame).
+*/
+template<typename Key, typename Value>
+class BoundedCache
+{
+
+public:
+
+	// The cached values
+	std::map<Key, std::shared_ptr<const Value>> _values;
+
+	// The mutex protecting the values
+	std::mutex _mutex;
+
+	// The maximum number of cached values
+	size_t _capacity;
+
+	/*
+	Constructor of the class
+	@param int capacity The maximum number of cached values
+	*/
+	BoundedCache(int capacity = BOUNDED_CACHE_SIZE) :
+		_capacity((size_t)capacity)
+	{
+	}
+
+	/*
+	Returns the cached value of the given key.
+	@param const Key & key The key
+	@return std::shared_ptr<const Value> The pointer to the value (empty if it is not cached)
+	*/
+	std::shared_ptr<const Value> Find(const Key & key)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		typename std::map<Key, std::shared_ptr<const Value>>::iterator it = _values.find(key);
+		return (it != _values.end()) ? it->second : std::shared_ptr<const Value>();
+	}
+
+	/*
+	Stores the value of the given key (dropping every value if the cache is full) and returns it.
+	@param const Key & key The key
+	@param std::shared_ptr<const Value> value The pointer to the value
+	@return std::shared_ptr<const Value> The pointer to the value
+	*/
+	std::shared_ptr<const Value> Insert(const Key & key, std::shared_ptr<const Value> value)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_values.size() >= _capacity)
+		{
+			_values.clear();
+		}
+		_values[key] = value;
+		return value;
+	}
+
+};
+
+#endif
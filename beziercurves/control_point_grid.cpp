@@ -0,0 +1,121 @@
+#include "control_point_grid.h"
+#include <algorithm>
+#include <cmath>
+
+ControlPointGrid::ControlPointGrid(double cellSize) :
+	_cellSize(cellSize)
+{
+}
+
+ControlPointGrid::~ControlPointGrid()
+{
+}
+
+void ControlPointGrid::Build(const ControlPoints * controlPoints)
+{
+	// Remove the previous control points
+	_cells.clear();
+	_keys.clear();
+
+	// Add the control points in order
+	int nPoints = controlPoints->size();
+	_keys.reserve(nPoints);
+	for (int i = 0; i < nPoints; i += 1)
+	{
+		push_back(controlPoints->_x[i], controlPoints->_y[i]);
+	}
+}
+
+long long ControlPointGrid::CellKey(long long i, long long j)
+{
+	// Join the column and the row (32 bits each)
+	return (i << 32) ^ (j & 0xffffffffLL);
+}
+
+void ControlPointGrid::Erase(int index)
+{
+	// Remove the index from its cell (and the cell if it is left empty)
+	std::unordered_map<long long, std::vector<int>>::iterator cell = _cells.find(_keys[index]);
+	cell->second.erase(std::find(cell->second.begin(), cell->second.end(), index));
+	if (cell->second.empty())
+	{
+		_cells.erase(cell);
+	}
+	_keys.erase(_keys.begin() + index);
+
+	// Decrease the indices of the following control points
+	int nPoints = _keys.size();
+	for (int i = index; i < nPoints; i += 1)
+	{
+		std::vector<int> & indices = _cells[_keys[i]];
+		*std::find(indices.begin(), indices.end(), i + 1) = i;
+	}
+}
+
+int ControlPointGrid::Find(const ControlPoints * controlPoints, double x, double y, double halfSize) const
+{
+	// Get the range of cells overlapping the square of the position (it contains every control point whose square contains it)
+	long long iMin = (long long)std::floor((x - halfSize) / _cellSize);
+	long long iMax = (long long)std::floor((x + halfSize) / _cellSize);
+	long long jMin = (long long)std::floor((y - halfSize) / _cellSize);
+	long long jMax = (long long)std::floor((y + halfSize) / _cellSize);
+
+	// Check the control points of the cells and keep the lowest index
+	int found = -1;
+	for (long long i = iMin; i <= iMax; i += 1)
+	{
+		for (long long j = jMin; j <= jMax; j += 1)
+		{
+			std::unordered_map<long long, std::vector<int>>::const_iterator cell = _cells.find(CellKey(i, j));
+			if (cell == _cells.end())
+			{
+				continue;
+			}
+
+			int nIndices = cell->second.size();
+			for (int k = 0; k < nIndices; k += 1)
+			{
+				int index = cell->second[k];
+				double px = controlPoints->_x[index];
+				double py = controlPoints->_y[index];
+				if ((found < 0 || index < found) && x >= px - halfSize && x <= px + halfSize && y >= py - halfSize && y <= py + halfSize)
+				{
+					found = index;
+				}
+			}
+		}
+	}
+
+	// Return the index of the control point
+	return found;
+}
+
+void ControlPointGrid::Move(int index, double x, double y)
+{
+	// If the control point stays in its cell then exit the function
+	long long key = CellKey((long long)std::floor(x / _cellSize), (long long)std::floor(y / _cellSize));
+	if (key == _keys[index])
+	{
+		return;
+	}
+
+	// Remove the index from its previous cell (and the cell if it is left empty)
+	std::unordered_map<long long, std::vector<int>>::iterator cell = _cells.find(_keys[index]);
+	cell->second.erase(std::find(cell->second.begin(), cell->second.end(), index));
+	if (cell->second.empty())
+	{
+		_cells.erase(cell);
+	}
+
+	// Add the index to its new cell
+	_cells[key].push_back(index);
+	_keys[index] = key;
+}
+
+void ControlPointGrid::push_back(double x, double y)
+{
+	// Add the index of the control point to its cell
+	long long key = CellKey((long long)std::floor(x / _cellSize), (long long)std::floor(y / _cellSize));
+	_cells[key].push_back(_keys.size());
+	_keys.push_back(key);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#ifndef _CONTROL_POINT_GRID_H_
+#define _CONTROL_POINT_GRID_H_
+
+#include "control_points.h"
+#include <unordered_map>
+#include <vector>
+
+/*
+The class representing a uniform hash grid over a set of control points. Every control point is stored in the cell containing
+it, and only the cells with control points are kept (in a hash map), so finding the control points near a position only looks
+at the few cells around it.
+*/
+class ControlPointGrid
+{
+
+public:
+
+	// The length of the sides of the cells
+	double _cellSize;
+
+	// The indices of the control points in every non empty cell
+	std::unordered_map<long long, std::vector<int>> _cells;
+
+	// The key of the cell of every control point
+	std::vector<long long> _keys;
+
+	/*
+	Constructor of the class
+	@param double cellSize The length of the sides of the cells
+	*/
+	ControlPointGrid(double cellSize);
+
+	/*
+	Destructor of the class
+	*/
+	~ControlPointGrid();
+
+	/*
+	Stores the given control points, replacing the previous ones.
+	@param const ControlPoints * controlPoints The control points
+	*/
+	void Build(const ControlPoints * controlPoints);
+
+	/*
+	Returns the key of the cell at the given cell coordinates.
+	@param long long i The column of the cell
+	@param long long j The row of the cell
+	@return long long The key of the cell
+	*/
+	static long long CellKey(long long i, long long j);
+
+	/*
+	Removes a control point. The indices of the following control points are decreased by one, as in ControlPoints::erase.
+	@param int index The index of the control point
+	*/
+	void Erase(int index);
+
+	/*
+	Returns the first control point whose square (centered at the control point) contains the given position.
+	@param const ControlPoints * controlPoints The control points stored in the grid
+	@param double x The X coordinate of the position
+	@param double y The Y coordinate of the position
+	@param double halfSize The half of the length of the sides of the squares
+	@return int The lowest index of the control points containing the position, or -1 if there is none
+	*/
+	int Find(const ControlPoints * controlPoints, double x, double y, double halfSize) const;
+
+	/*
+	Moves a control point to the cell containing its new position.
+	@param int index The index of the control point
+	@param double x The new X coordinate of the control point
+	@param double y The new Y coordinate of the control point
+	*/
+	void Move(int index, double x, double y);
+
+	/*
+	Adds a control point after the stored ones.
+	@param double x The X coordinate of the control point
+	@param double y The Y coordinate of the control point
+	*/
+	void push_back(double x, double y);
+
+};
+
+#endif
@@ -0,0 +1,184 @@
+#include "control_points.h"
+#include "utils.h"
+
+ControlPoints::ControlPoints() :
+	_x(NULL),
+	_y(NULL),
+	_z(NULL),
+	_w(NULL),
+	_size(0),
+	_capacity(0)
+{
+}
+
+ControlPoints::ControlPoints(const ControlPoints & other) :
+	_x(NULL),
+	_y(NULL),
+	_z(NULL),
+	_w(NULL),
+	_size(0),
+	_capacity(0)
+{
+	// Copy the control points of the other set
+	*this = other;
+}
+
+ControlPoints::~ControlPoints()
+{
+	// The four coordinate arrays share the same block, which starts at the X array
+	Utils::AlignedFree(_x);
+}
+
+ControlPoints & ControlPoints::operator=(const ControlPoints & other)
+{
+	// Nothing to do if it is the same set of control points
+	if (this == &other)
+	{
+		return *this;
+	}
+
+	// Make sure the other control points fit
+	reserve(other._size);
+
+	// Copy the coordinates
+	for (int i = 0; i < other._size; i += 1)
+	{
+		_x[i] = other._x[i];
+		_y[i] = other._y[i];
+		_z[i] = other._z[i];
+		_w[i] = other._w[i];
+	}
+
+	// Update the number of control points
+	_size = other._size;
+
+	// Return the reference to the current control points
+	return *this;
+}
+
+Point ControlPoints::at(int index) const
+{
+	return Point(_x[index], _y[index], _z[index], _w[index]);
+}
+
+void ControlPoints::clear()
+{
+	_size = 0;
+}
+
+void ControlPoints::erase(int index)
+{
+	// Shift the control points after the given index one place to the left
+	for (int i = index; i < _size - 1; i += 1)
+	{
+		_x[i] = _x[i + 1];
+		_y[i] = _y[i + 1];
+		_z[i] = _z[i + 1];
+		_w[i] = _w[i + 1];
+	}
+
+	// Decrease the number of control points
+	_size -= 1;
+}
+
+void ControlPoints::FromHomogeneous()
+{
+	for (int i = 0; i < _size; i += 1)
+	{
+		_x[i] /= _w[i];
+		_y[i] /= _w[i];
+		_z[i] /= _w[i];
+	}
+}
+
+void ControlPoints::push_back(double x, double y, double z, double w)
+{
+	// Double the capacity if the arrays are full
+	if (_size == _capacity)
+	{
+		reserve(_capacity == 0 ? 8 : _capacity * 2);
+	}
+
+	// Store the coordinates of the new control point
+	_x[_size] = (ControlScalar)x;
+	_y[_size] = (ControlScalar)y;
+	_z[_size] = (ControlScalar)z;
+	_w[_size] = (ControlScalar)w;
+
+	// Increase the number of control points
+	_size += 1;
+}
+
+void ControlPoints::reserve(int capacity)
+{
+	// Nothing to do if the arrays are already large enough
+	if (capacity <= _capacity)
+	{
+		return;
+	}
+
+	// Round the capacity so every coordinate array starts at an aligned address
+	int perAlignment = CONTROL_POINTS_ALIGNMENT / sizeof(ControlScalar);
+	capacity = ((capacity + perAlignment - 1) / perAlignment) * perAlignment;
+
+	// Allocate a single block for the four coordinate arrays
+	ControlScalar * block = (ControlScalar *)Utils::AlignedAlloc(4 * capacity * sizeof(ControlScalar), CONTROL_POINTS_ALIGNMENT);
+
+	// Copy the current coordinates into the new block
+	for (int i = 0; i < _size; i += 1)
+	{
+		block[i] = _x[i];
+		block[capacity + i] = _y[i];
+		block[(2 * capacity) + i] = _z[i];
+		block[(3 * capacity) + i] = _w[i];
+	}
+
+	// Release the previous block
+	Utils::AlignedFree(_x);
+
+	// Set the coordinate arrays
+	_x = block;
+	_y = block + capacity;
+	_z = block + (2 * capacity);
+	_w = block + (3 * capacity);
+
+	// Update the capacity
+	_capacity = capacity;
+}
+
+void ControlPoints::set(int index, double x, double y)
+{
+	_x[index] = (ControlScalar)x;
+	_y[index] = (ControlScalar)y;
+}
+
+int ControlPoints::size() const
+{
+	return _size;
+}
+
+void ControlPoints::ToHomogeneous()
+{
+	for (int i = 0; i < _size; i += 1)
+	{
+		_x[i] *= _w[i];
+		_y[i] *= _w[i];
+		_z[i] *= _w[i];
+	}
+}
+
+std::vector<Point *> * ControlPoints::ToPointVector() const
+{
+	// Initialize the vector for storing the points
+	std::vector<Point *> * points = new std::vector<Point *>();
+	points->reserve(_size);
+
+	// Generate a point for every control point
+	for (int i = 0; i < _size; i += 1)
+	{
+		points->push_back(new Point(_x[i], _y[i], _z[i], _w[i]));
+	}
+
+	// Return the pointer to the vector with the points
+	return points;
+}
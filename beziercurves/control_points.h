@@ -0,0 +1,137 @@
+#pragma once
+
+#ifndef _CONTROL_POINTS_H_
+#define _CONTROL_POINTS_H_
+
+#include "point.h"
+#include <vector>
+
+// The scalar type used for storing the control point coordinates
+// NOTE: Define BEZIER_FLOAT_STORAGE for halving the memory used by the control points
+#ifdef BEZIER_FLOAT_STORAGE
+typedef float ControlScalar;
+#else
+typedef double ControlScalar;
+#endif
+
+// The alignment (in bytes) of every coordinate array
+const int CONTROL_POINTS_ALIGNMENT = 32;
+
+/*
+The class representing a set of control points stored as a structure of arrays. Each coordinate is
+stored in its own contiguous and aligned array, so evaluation loops read the control points linearly.
+*/
+class ControlPoints
+{
+
+public:
+
+	// The X coordinates of the control points
+	ControlScalar * _x;
+
+	// The Y coordinates of the control points
+	ControlScalar * _y;
+
+	// The Z coordinates of the control points
+	ControlScalar * _z;
+
+	// The W coordinates of the control points
+	ControlScalar * _w;
+
+	// The number of control points
+	int _size;
+
+	// The number of control points that fit in the allocated arrays
+	int _capacity;
+
+	/*
+	Constructor of the class
+	*/
+	ControlPoints();
+
+	/*
+	Copy constructor of the class
+	@param const ControlPoints & other The control points to be copied
+	*/
+	ControlPoints(const ControlPoints & other);
+
+	/*
+	Destructor of the class
+	*/
+	~ControlPoints();
+
+	/*
+	Copies the given control points into the current ones
+	@param const ControlPoints & other The control points to be copied
+	@return ControlPoints & The reference to the current control points
+	*/
+	ControlPoints & operator=(const ControlPoints & other);
+
+	/*
+	Returns the control point at the given index
+	@param int index The index of the control point
+	@return Point The control point
+	*/
+	Point at(int index) const;
+
+	/*
+	Removes all of the control points. The allocated arrays are kept.
+	*/
+	void clear();
+
+	/*
+	Removes the control point at the given index
+	@param int index The index of the control point
+	*/
+	void erase(int index);
+
+	/*
+	Divides the X, Y and Z coordinates of every control point by its W coordinate (the inverse of ToHomogeneous).
+	*/
+	void FromHomogeneous();
+
+	/*
+	Adds a new control point at the end
+	@param double x The X coordinate of the point
+	@param double y The Y coordinate of the point
+	@param double z The Z coordinate of the point
+	@param double w The W coordinate of the point (the weight of the point in rational curves)
+	*/
+	void push_back(double x, double y, double z = 0.0, double w = 1.0);
+
+	/*
+	Guarantees the arrays can store the given number of control points without reallocating
+	@param int capacity The number of control points
+	*/
+	void reserve(int capacity);
+
+	/*
+	Sets the X and Y coordinates of the control point at the given index
+	@param int index The index of the control point
+	@param double x The X coordinate of the point
+	@param double y The Y coordinate of the point
+	*/
+	void set(int index, double x, double y);
+
+	/*
+	Returns the number of control points
+	@return int The number of control points
+	*/
+	int size() const;
+
+	/*
+	Multiplies the X, Y and Z coordinates of every control point by its W coordinate, so the control points of a rational curve
+	can be combined linearly (subdivided, elevated, etc.) as the control points of a polynomial curve in one more dimension.
+	*/
+	void ToHomogeneous();
+
+	/*
+	Returns a pointer to a vector with a copy of the control points as Point objects.
+	NOTE: The vector and its points must be deleted using Utils::DeletePointVector
+	@return std::vector<Point *> * A pointer to the vector with the copy of the control points
+	*/
+	std::vector<Point *> * ToPointVector() const;
+
+};
+
+#endif
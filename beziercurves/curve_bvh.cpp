@@ -0,0 +1,421 @@
+#include "curve_bvh.h"
+#include "utils.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+/*
+Extends a box so it contains another one.
+@param double box[4] The box being extended (minimum X, minimum Y, maximum X, maximum Y)
+@param const double other[4] The box to be contained
+*/
+static void ExtendBox(double box[4], const double other[4])
+{
+	box[0] = (other[0] < box[0]) ? other[0] : box[0];
+	box[1] = (other[1] < box[1]) ? other[1] : box[1];
+	box[2] = (other[2] > box[2]) ? other[2] : box[2];
+	box[3] = (other[3] > box[3]) ? other[3] : box[3];
+}
+
+/*
+Returns the squared distance from a point to a box (0 if the point is inside of the box).
+@param const double box[4] The box (minimum X, minimum Y, maximum X, maximum Y)
+@param double x The X coordinate of the point
+@param double y The Y coordinate of the point
+@return double The squared distance
+*/
+static double BoxDistance2(const double box[4], double x, double y)
+{
+	double dx = (x < box[0]) ? box[0] - x : ((x > box[2]) ? x - box[2] : 0.0);
+	double dy = (y < box[1]) ? box[1] - y : ((y > box[3]) ? y - box[3] : 0.0);
+	return (dx * dx) + (dy * dy);
+}
+
+/*
+Indicates whether a curve crosses a segment of a vertical or a horizontal line. The parameters where the curve meets the line
+are the roots of the Bernstein polynomial with coefficients w_i (c_i - value), c being the X coordinates for a vertical line and
+the Y coordinates for a horizontal one.
+@param BezierCurve * curve The curve
+@param bool vertical If the line is vertical (X = value), otherwise it is horizontal (Y = value)
+@param double value The coordinate of the line
+@param double min The minimum value of the other coordinate of the segment
+@param double max The maximum value of the other coordinate of the segment
+@return bool If the curve meets the segment
+*/
+static bool CrossesSegment(BezierCurve * curve, bool vertical, double value, double min, double max)
+{
+	// The coefficients of the distance to the line and their roots (kept between calls)
+	static thread_local std::vector<double> coefficients;
+	static thread_local std::vector<double> roots;
+
+	// Calculate the coefficients
+	int nPoints = curve->_controlPoints->size();
+	coefficients.resize(nPoints);
+	for (int i = 0; i < nPoints; i += 1)
+	{
+		double w = curve->_rational ? curve->_controlPoints->_w[i] : 1.0;
+		double c = vertical ? curve->_controlPoints->_x[i] : curve->_controlPoints->_y[i];
+		coefficients[i] = w * (c - value);
+	}
+
+	// Find where the curve meets the line
+	roots.clear();
+	Utils::BernsteinRoots(coefficients.data(), nPoints, BOUNDING_BOX_TOLERANCE, roots);
+
+	// Check whether any of the points is within the segment
+	int nRoots = roots.size();
+	for (int i = 0; i < nRoots; i += 1)
+	{
+		Point p = curve->Evaluate(roots[i]);
+		double other = vertical ? p.y : p.x;
+		if (other >= min && other <= max)
+		{
+			return true;
+		}
+	}
+
+	// The curve does not meet the segment
+	return false;
+}
+
+CurveBVH::CurveBVH() :
+	_curves(NULL)
+{
+}
+
+CurveBVH::~CurveBVH()
+{
+}
+
+void CurveBVH::Build(std::vector<BezierCurve *> * curves)
+{
+	// Get the number of curves
+	_curves = curves;
+	int nCurves = curves->size();
+
+	// Calculate the boxes of the curves and keep the ones with control points
+	_boxes.resize(8 * nCurves);
+	_versions.resize(nCurves);
+	_leaves.assign(nCurves, -1);
+	_indices.clear();
+	for (int i = 0; i < nCurves; i += 1)
+	{
+		BezierCurve * curve = curves->at(i);
+		curve->BoundingBox(_boxes.data() + (8 * i));
+		curve->ControlPolygonBox(_boxes.data() + (8 * i) + 4);
+		_versions[i] = curve->_version;
+		if (curve->_controlPoints->size() > 0)
+		{
+			_indices.push_back(i);
+		}
+	}
+
+	// Build the nodes from the root
+	_nodes.clear();
+	if (!_indices.empty())
+	{
+		_nodes.reserve((2 * _indices.size()) / CURVE_BVH_LEAF_SIZE + 1);
+		BuildNode(0, _indices.size(), -1);
+	}
+}
+
+int CurveBVH::BuildNode(int first, int last, int parent)
+{
+	// Add the node (the nodes vector may grow while building the children, so it is accessed by index)
+	int index = _nodes.size();
+	CurveBVHNode node;
+	node._parent = parent;
+	node._left = node._right = -1;
+	node._first = first;
+	node._count = last - first;
+
+	// Join the boxes of the curves and find the box of their centers
+	double centers[4] = { INFINITY, INFINITY, -INFINITY, -INFINITY };
+	node._box[0] = node._box[1] = node._controlBox[0] = node._controlBox[1] = INFINITY;
+	node._box[2] = node._box[3] = node._controlBox[2] = node._controlBox[3] = -INFINITY;
+	for (int i = first; i < last; i += 1)
+	{
+		const double * boxes = _boxes.data() + (8 * _indices[i]);
+		ExtendBox(node._box, boxes);
+		ExtendBox(node._controlBox, boxes + 4);
+		double center[4] = { 0.5 * (boxes[0] + boxes[2]), 0.5 * (boxes[1] + boxes[3]), 0.0, 0.0 };
+		center[2] = center[0];
+		center[3] = center[1];
+		ExtendBox(centers, center);
+	}
+	_nodes.push_back(node);
+
+	// If there are few curves then the node is a leaf
+	if (last - first <= CURVE_BVH_LEAF_SIZE)
+	{
+		for (int i = first; i < last; i += 1)
+		{
+			_leaves[_indices[i]] = index;
+		}
+		return index;
+	}
+
+	// Split the curves at the median of their centers along the longest side
+	int axis = (centers[2] - centers[0] >= centers[3] - centers[1]) ? 0 : 1;
+	int middle = (first + last) / 2;
+	const double * boxes = _boxes.data();
+	std::nth_element(_indices.begin() + first, _indices.begin() + middle, _indices.begin() + last, [boxes, axis](int i, int j)
+	{
+		return boxes[(8 * i) + axis] + boxes[(8 * i) + axis + 2] < boxes[(8 * j) + axis] + boxes[(8 * j) + axis + 2];
+	});
+
+	// Build the children
+	int left = BuildNode(first, middle, index);
+	int right = BuildNode(middle, last, index);
+	_nodes[index]._left = left;
+	_nodes[index]._right = right;
+	_nodes[index]._count = 0;
+	return index;
+}
+
+void CurveBVH::ControlPointsInRadius(double x, double y, double radius, std::vector<std::pair<int, int>> & out)
+{
+	// If the hierarchy is empty then exit the function
+	if (_nodes.empty())
+	{
+		return;
+	}
+
+	// Visit the nodes whose control points box is within the distance, starting from the root
+	double radius2 = radius * radius;
+	std::vector<int> stack(1, 0);
+	while (!stack.empty())
+	{
+		const CurveBVHNode & node = _nodes[stack.back()];
+		stack.pop_back();
+		if (BoxDistance2(node._controlBox, x, y) > radius2)
+		{
+			continue;
+		}
+
+		// Visit the children of an inner node
+		if (node._count == 0)
+		{
+			stack.push_back(node._left);
+			stack.push_back(node._right);
+			continue;
+		}
+
+		// Check the control points of the curves of a leaf
+		for (int i = node._first; i < node._first + node._count; i += 1)
+		{
+			int curve = _indices[i];
+			if (BoxDistance2(_boxes.data() + (8 * curve) + 4, x, y) > radius2)
+			{
+				continue;
+			}
+
+			ControlPoints * controlPoints = _curves->at(curve)->_controlPoints;
+			int nPoints = controlPoints->size();
+			for (int j = 0; j < nPoints; j += 1)
+			{
+				double dx = controlPoints->_x[j] - x;
+				double dy = controlPoints->_y[j] - y;
+				if ((dx * dx) + (dy * dy) <= radius2)
+				{
+					out.push_back(std::make_pair(curve, j));
+				}
+			}
+		}
+	}
+}
+
+void CurveBVH::CurvesInRect(double minX, double minY, double maxX, double maxY, std::vector<int> & out)
+{
+	// If the hierarchy is empty then exit the function
+	if (_nodes.empty())
+	{
+		return;
+	}
+
+	// Visit the nodes whose box overlaps the rectangle, starting from the root
+	std::vector<int> stack(1, 0);
+	while (!stack.empty())
+	{
+		const CurveBVHNode & node = _nodes[stack.back()];
+		stack.pop_back();
+		if (node._box[0] > maxX || node._box[2] < minX || node._box[1] > maxY || node._box[3] < minY)
+		{
+			continue;
+		}
+
+		// Visit the children of an inner node
+		if (node._count == 0)
+		{
+			stack.push_back(node._left);
+			stack.push_back(node._right);
+			continue;
+		}
+
+		// Test the curves of a leaf
+		for (int i = node._first; i < node._first + node._count; i += 1)
+		{
+			int index = _indices[i];
+			const double * box = _boxes.data() + (8 * index);
+			if (box[0] > maxX || box[2] < minX || box[1] > maxY || box[3] < minY)
+			{
+				continue;
+			}
+
+			// Take the curve if its box is inside of the rectangle
+			if (box[0] >= minX && box[2] <= maxX && box[1] >= minY && box[3] <= maxY)
+			{
+				out.push_back(index);
+				continue;
+			}
+
+			// Otherwise the curve is partially inside if it starts inside or if it crosses any side of the rectangle
+			BezierCurve * curve = _curves->at(index);
+			double x0 = curve->_controlPoints->_x[0];
+			double y0 = curve->_controlPoints->_y[0];
+			if ((x0 >= minX && x0 <= maxX && y0 >= minY && y0 <= maxY) ||
+				CrossesSegment(curve, true, minX, minY, maxY) ||
+				CrossesSegment(curve, true, maxX, minY, maxY) ||
+				CrossesSegment(curve, false, minY, minX, maxX) ||
+				CrossesSegment(curve, false, maxY, minX, maxX))
+			{
+				out.push_back(index);
+			}
+		}
+	}
+}
+
+int CurveBVH::NearestCurve(double x, double y, double maxDistance, CurveProjection * projection)
+{
+	// If the hierarchy is empty then there is no curve
+	if (_nodes.empty())
+	{
+		return -1;
+	}
+
+	// The nearest curve found so far and its closest point
+	int nearest = -1;
+	CurveProjection best;
+	double bestDistance2 = maxDistance * maxDistance;
+
+	// The nodes to be visited sorted by the distance to their boxes, starting from the root
+	typedef std::pair<double, int> QueueItem;
+	std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+	queue.push(std::make_pair(BoxDistance2(_nodes[0]._box, x, y), 0));
+	while (!queue.empty())
+	{
+		// Stop when the nearest box is farther than the nearest curve
+		QueueItem item = queue.top();
+		queue.pop();
+		if (item.first > bestDistance2)
+		{
+			break;
+		}
+
+		// Queue the children of an inner node
+		const CurveBVHNode & node = _nodes[item.second];
+		if (node._count == 0)
+		{
+			queue.push(std::make_pair(BoxDistance2(_nodes[node._left]._box, x, y), node._left));
+			queue.push(std::make_pair(BoxDistance2(_nodes[node._right]._box, x, y), node._right));
+			continue;
+		}
+
+		// Project the point onto the curves of a leaf whose box is near enough
+		for (int i = node._first; i < node._first + node._count; i += 1)
+		{
+			int index = _indices[i];
+			if (BoxDistance2(_boxes.data() + (8 * index), x, y) > bestDistance2)
+			{
+				continue;
+			}
+
+			CurveProjection current = _curves->at(index)->ClosestPoint(Point(x, y));
+			if (current._distance * current._distance <= bestDistance2)
+			{
+				nearest = index;
+				best = current;
+				bestDistance2 = current._distance * current._distance;
+			}
+		}
+	}
+
+	// Return the nearest curve and its closest point
+	if (nearest > -1 && projection != NULL)
+	{
+		*projection = best;
+	}
+	return nearest;
+}
+
+void CurveBVH::Refit(int index)
+{
+	// Calculate the boxes of the curve again
+	BezierCurve * curve = _curves->at(index);
+	curve->BoundingBox(_boxes.data() + (8 * index));
+	curve->ControlPolygonBox(_boxes.data() + (8 * index) + 4);
+	_versions[index] = curve->_version;
+
+	// If the curve is not in the tree then exit the function
+	int leaf = _leaves[index];
+	if (leaf < 0)
+	{
+		return;
+	}
+
+	// Join the boxes of the curves of the leaf
+	CurveBVHNode & node = _nodes[leaf];
+	node._box[0] = node._box[1] = node._controlBox[0] = node._controlBox[1] = INFINITY;
+	node._box[2] = node._box[3] = node._controlBox[2] = node._controlBox[3] = -INFINITY;
+	for (int i = node._first; i < node._first + node._count; i += 1)
+	{
+		ExtendBox(node._box, _boxes.data() + (8 * _indices[i]));
+		ExtendBox(node._controlBox, _boxes.data() + (8 * _indices[i]) + 4);
+	}
+
+	// Join the boxes of the children of every node up to the root
+	for (int parent = node._parent; parent > -1; parent = _nodes[parent]._parent)
+	{
+		CurveBVHNode & inner = _nodes[parent];
+		const CurveBVHNode & left = _nodes[inner._left];
+		const CurveBVHNode & right = _nodes[inner._right];
+		for (int k = 0; k < 4; k += 1)
+		{
+			inner._box[k] = left._box[k];
+			inner._controlBox[k] = left._controlBox[k];
+		}
+		ExtendBox(inner._box, right._box);
+		ExtendBox(inner._controlBox, right._controlBox);
+	}
+}
+
+void CurveBVH::Update(std::vector<BezierCurve *> * curves)
+{
+	// Build the hierarchy again if the curves changed
+	int nCurves = curves->size();
+	if (curves != _curves || nCurves != (int)_versions.size())
+	{
+		Build(curves);
+		return;
+	}
+
+	// Refit the curves whose control points changed
+	for (int i = 0; i < nCurves; i += 1)
+	{
+		BezierCurve * curve = curves->at(i);
+		if (curve->_version == _versions[i])
+		{
+			continue;
+		}
+
+		// A curve entering or leaving the tree changes its structure
+		if ((_leaves[i] < 0) != (curve->_controlPoints->size() == 0))
+		{
+			Build(curves);
+			return;
+		}
+
+		Refit(i);
+	}
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#ifndef _CURVE_BVH_H_
+#define _CURVE_BVH_H_
+
+#include "bezier_curve.h"
+#include <utility>
+#include <vector>
+
+// The maximum number of curves stored in a leaf of the hierarchy
+const int CURVE_BVH_LEAF_SIZE = 4;
+
+/*
+A node of the bounding volume hierarchy. Inner nodes have two children, leaves store a range of the curve indices.
+*/
+struct CurveBVHNode
+{
+	// The bounding box of the curves below the node (minimum X, minimum Y, maximum X, maximum Y)
+	double _box[4];
+
+	// The bounding box of the control points of the curves below the node
+	double _controlBox[4];
+
+	// The index of the parent node (-1 for the root)
+	int _parent;
+
+	// The indices of the children nodes (-1 for leaves)
+	int _left, _right;
+
+	// The first position of the curves of a leaf in the indices vector
+	int _first;
+
+	// The number of curves of a leaf (0 for inner nodes)
+	int _count;
+};
+
+/*
+The class representing a bounding volume hierarchy over a set of curves. Every node keeps the tight bounding box of its curves
+(see BezierCurve::BoundingBox) for the curve queries and the box of their control points for the control point queries. Edited
+curves are refitted, this is, their boxes are updated from their leaf to the root without changing the tree.
+NOTE: The curves are not owned by the hierarchy. Curves without control points are left out of the tree.
+*/
+class CurveBVH
+{
+
+public:
+
+	// The curves of the hierarchy
+	std::vector<BezierCurve *> * _curves;
+
+	// The nodes of the hierarchy, the root is the first one
+	std::vector<CurveBVHNode> _nodes;
+
+	// The indices of the curves sorted by leaf
+	std::vector<int> _indices;
+
+	// The leaf of every curve (-1 for curves left out of the tree)
+	std::vector<int> _leaves;
+
+	// The bounding box and the control points box of every curve (8 values per curve)
+	std::vector<double> _boxes;
+
+	// The version of the control points of every curve when its boxes were calculated
+	std::vector<int> _versions;
+
+	/*
+	Constructor of the class
+	*/
+	CurveBVH();
+
+	/*
+	Destructor of the class
+	*/
+	~CurveBVH();
+
+	/*
+	Builds the hierarchy over the given curves. Nodes are split at the median of the centers of the boxes of their curves along
+	the longest side of the box of the centers.
+	@param std::vector<BezierCurve *> * curves The curves
+	*/
+	void Build(std::vector<BezierCurve *> * curves);
+
+	/*
+	Builds the node of the curves in the range [first, last) of the indices vector and the nodes below it.
+	@param int first The first position of the range
+	@param int last The last position of the range (exclusive)
+	@param int parent The index of the parent node
+	@return int The index of the node
+	*/
+	int BuildNode(int first, int last, int parent);
+
+	/*
+	Finds the control points of every curve within the given distance of a point.
+	@param double x The X coordinate of the point
+	@param double y The Y coordinate of the point
+	@param double radius The distance
+	@param std::vector<std::pair<int, int>> & out The vector where the indices of the curves and of their control points are
+	appended
+	*/
+	void ControlPointsInRadius(double x, double y, double radius, std::vector<std::pair<int, int>> & out);
+
+	/*
+	Finds the curves with at least one point inside of the given rectangle. Curves whose box is inside of the rectangle are taken
+	directly, otherwise a curve is taken if its first point is inside of the rectangle or if it crosses one of its sides.
+	@param double minX The minimum X coordinate of the rectangle
+	@param double minY The minimum Y coordinate of the rectangle
+	@param double maxX The maximum X coordinate of the rectangle
+	@param double maxY The maximum Y coordinate of the rectangle
+	@param std::vector<int> & out The vector where the indices of the curves are appended
+	*/
+	void CurvesInRect(double minX, double minY, double maxX, double maxY, std::vector<int> & out);
+
+	/*
+	Finds the curve nearest to a point. Nodes are visited by the distance from the point to their boxes, and the search stops
+	once the nearest box is farther than the nearest curve found (see BezierCurve::ClosestPoint).
+	@param double x The X coordinate of the point
+	@param double y The Y coordinate of the point
+	@param double maxDistance The maximum distance of the curve
+	@param CurveProjection * projection The closest point of the curve found (ignored if NULL)
+	@return int The index of the nearest curve, or -1 if there is no curve within the maximum distance
+	*/
+	int NearestCurve(double x, double y, double maxDistance, CurveProjection * projection);
+
+	/*
+	Updates the boxes of a curve, and the boxes of the nodes from its leaf to the root.
+	@param int index The index of the curve
+	*/
+	void Refit(int index);
+
+	/*
+	Refits the curves whose control points changed since their boxes were calculated. The hierarchy is built again if the
+	curves vector or its size changed, or if a curve gained its first control point or lost its last one.
+	@param std::vector<BezierCurve *> * curves The curves
+	*/
+	void Update(std::vector<BezierCurve *> * curves);
+
+};
+
+#endif
@@ -0,0 +1,477 @@
+#include "curve_intersector.h"
+#include "utils.h"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+// The fraction of the parameter interval a clipping step must keep for the part to be split in half instead
+const double INTERSECTION_SPLIT_RATIO = 0.8;
+
+/*
+Keeps the part [0, t] of a curve, running DeCasteljau's algorithm in place over its X, Y and W arrays.
+@param double * points The X, Y and W arrays of the control points, one after the other
+@param int n The number of control points
+@param double t The cutting parameter
+*/
+static void KeepLeft(double * points, int n, double t)
+{
+	double _t = 1.0 - t;
+	for (int c = 0; c < 3; c += 1)
+	{
+		double * v = points + (c * n);
+		for (int k = 1; k < n; k += 1)
+		{
+			for (int i = n - 1; i >= k; i -= 1)
+			{
+				v[i] = (_t * v[i - 1]) + (t * v[i]);
+			}
+		}
+	}
+}
+
+/*
+Keeps the part [t, 1] of a curve, running DeCasteljau's algorithm in place over its X, Y and W arrays.
+@param double * points The X, Y and W arrays of the control points, one after the other
+@param int n The number of control points
+@param double t The cutting parameter
+*/
+static void KeepRight(double * points, int n, double t)
+{
+	double _t = 1.0 - t;
+	for (int c = 0; c < 3; c += 1)
+	{
+		double * v = points + (c * n);
+		for (int k = 1; k < n; k += 1)
+		{
+			for (int i = 0; i < n - k; i += 1)
+			{
+				v[i] = (_t * v[i]) + (t * v[i + 1]);
+			}
+		}
+	}
+}
+
+/*
+Calculates the bounding box of the control points of a part, projected from homogeneous coordinates.
+@param const double * points The X, Y and W arrays of the control points, one after the other
+@param int n The number of control points
+@param double box[4] The array where the box is stored (minimum X, minimum Y, maximum X, maximum Y)
+*/
+static void BoundingBox(const double * points, int n, double box[4])
+{
+	box[0] = box[1] = INFINITY;
+	box[2] = box[3] = -INFINITY;
+	for (int i = 0; i < n; i += 1)
+	{
+		double x = points[i] / points[(2 * n) + i];
+		double y = points[n + i] / points[(2 * n) + i];
+		box[0] = (x < box[0]) ? x : box[0];
+		box[1] = (y < box[1]) ? y : box[1];
+		box[2] = (x > box[2]) ? x : box[2];
+		box[3] = (y > box[3]) ? y : box[3];
+	}
+}
+
+/*
+Loads the control points of a curve in homogeneous coordinates (polynomial curves have weight 1).
+@param const BezierCurve * curve The curve
+@param double * points The X, Y and W arrays where the control points are stored, one after the other
+*/
+static void LoadHomogeneous(const BezierCurve * curve, double * points)
+{
+	int n = curve->_controlPoints->size();
+	for (int i = 0; i < n; i += 1)
+	{
+		double w = curve->_rational ? curve->_controlPoints->_w[i] : 1.0;
+		points[i] = w * curve->_controlPoints->_x[i];
+		points[n + i] = w * curve->_controlPoints->_y[i];
+		points[(2 * n) + i] = w;
+	}
+}
+
+CurveIntersector::CurveIntersector(double tolerance) :
+	_tolerance(tolerance)
+{
+}
+
+CurveIntersector::~CurveIntersector()
+{
+}
+
+bool CurveIntersector::Clip(const double * p, int nP, const double * q, int nQ, double & tMin, double & tMax)
+{
+	// By default the whole interval is kept
+	tMin = 0.0;
+	tMax = 1.0;
+
+	// Get the line through the end points of the fat line curve (if they are the same use its farthest control point instead)
+	const double * qx = q;
+	const double * qy = q + nQ;
+	double dx = qx[nQ - 1] - qx[0];
+	double dy = qy[nQ - 1] - qy[0];
+	double length = std::sqrt((dx * dx) + (dy * dy));
+	for (int i = 1; i < nQ - 1 && length == 0.0; i += 1)
+	{
+		double ex = qx[i] - qx[0];
+		double ey = qy[i] - qy[0];
+		double l = std::sqrt((ex * ex) + (ey * ey));
+		if (l > length)
+		{
+			dx = ex;
+			dy = ey;
+			length = l;
+		}
+	}
+
+	// If the fat line curve is a single point then nothing can be clipped
+	if (length == 0.0)
+	{
+		return true;
+	}
+
+	// Get the normalized equation of the line, nx X + ny Y + c = 0
+	double nx = -dy / length;
+	double ny = dx / length;
+	double c = -((nx * qx[0]) + (ny * qy[0]));
+
+	// Get the band of the fat line from the distances of the control points (the line itself is always in the band)
+	double dMin = 0.0;
+	double dMax = 0.0;
+	for (int i = 0; i < nQ; i += 1)
+	{
+		double d = (nx * qx[i]) + (ny * qy[i]) + c;
+		dMin = (d < dMin) ? d : dMin;
+		dMax = (d > dMax) ? d : dMax;
+	}
+
+	// Widen the band by the rounding error of the distances
+	double slack = 1e-12 * (length + std::fabs(c));
+	dMin -= slack;
+	dMax += slack;
+
+	// Get the distance control points of the clipped curve, (i / n, d_i)
+	// NOTE: They are already sorted by their X coordinate, so the monotone chain runs without sorting them
+	const double * px = p;
+	const double * py = p + nP;
+	_distances.resize(nP);
+	for (int i = 0; i < nP; i += 1)
+	{
+		_distances[i].set((double)i / (double)(nP - 1), (nx * px[i]) + (ny * py[i]) + c, 0.0, 0.0);
+	}
+
+	// Build the lower chain of the convex hull from left to right
+	_hull.clear();
+	for (int i = 0; i < nP; i += 1)
+	{
+		while (_hull.size() >= 2 && Utils::IsLeft(&_distances[i], &_hull[_hull.size() - 2], &_hull[_hull.size() - 1]) <= 0)
+		{
+			_hull.pop_back();
+		}
+		_hull.push_back(_distances[i]);
+	}
+
+	// Build the upper chain from right to left (the last point of the lower chain is its first point)
+	size_t lowerSize = _hull.size();
+	for (int i = nP - 2; i >= 0; i -= 1)
+	{
+		while (_hull.size() > lowerSize && Utils::IsLeft(&_distances[i], &_hull[_hull.size() - 2], &_hull[_hull.size() - 1]) <= 0)
+		{
+			_hull.pop_back();
+		}
+		_hull.push_back(_distances[i]);
+	}
+
+	// Remove the first point, which closes the upper chain
+	_hull.pop_back();
+
+	// Find the extent of the hull inside of the band: its vertices in the band and the crossings of its edges with the band
+	double low = INFINITY;
+	double high = -INFINITY;
+	int nHull = _hull.size();
+	for (int i = 0; i < nHull; i += 1)
+	{
+		Point & a = _hull[i];
+		Point & b = _hull[(i + 1) % nHull];
+
+		// Add the vertex if it is inside of the band
+		if (a.y >= dMin && a.y <= dMax)
+		{
+			low = (a.x < low) ? a.x : low;
+			high = (a.x > high) ? a.x : high;
+		}
+
+		// Add the crossings of the edge with both borders of the band
+		double borders[2] = { dMin, dMax };
+		for (int k = 0; k < 2; k += 1)
+		{
+			if ((a.y - borders[k]) * (b.y - borders[k]) < 0.0)
+			{
+				double x = a.x + (((borders[k] - a.y) * (b.x - a.x)) / (b.y - a.y));
+				low = (x < low) ? x : low;
+				high = (x > high) ? x : high;
+			}
+		}
+	}
+
+	// If the hull does not touch the band then there is no intersection
+	if (low > high)
+	{
+		return false;
+	}
+
+	// Return the clamped interval
+	tMin = (low < 0.0) ? 0.0 : low;
+	tMax = (high > 1.0) ? 1.0 : high;
+	return true;
+}
+
+int CurveIntersector::Intersect(const BezierCurve * first, const BezierCurve * second, std::vector<std::pair<double, double>> & out)
+{
+	// Get the number of control points of both curves, if any of them is a single point there is no intersection
+	int nA = first->_controlPoints->size();
+	int nB = second->_controlPoints->size();
+	if (nA < 2 || nB < 2)
+	{
+		return 0;
+	}
+
+	// Curves can only be clipped if neither of them is rational
+	bool clipping = !first->_rational && !second->_rational;
+
+	// Make room for the current pair and the halves of its parts
+	_work.resize(9 * (nA + nB));
+	_points.clear();
+	_pairs.clear();
+	_found.clear();
+
+	// Store the whole curves as the first pair
+	double * a = _work.data();
+	double * b = a + (3 * nA);
+	LoadHomogeneous(first, a);
+	LoadHomogeneous(second, b);
+	PushPair(a, nA, b, nB, 0.0, 1.0, 0.0, 1.0, 0, false);
+
+	// Process the pending pairs (overlapping curves never stop splitting, so the number of steps is limited)
+	int steps = 0;
+	while (!_pairs.empty() && steps < INTERSECTION_MAX_STEPS)
+	{
+		steps += 1;
+
+		// Take the last pair and copy its control points (its storage is at the end of the buffer, so it is released)
+		IntersectionPair pair = _pairs.back();
+		_pairs.pop_back();
+		int nP = pair._swapped ? nB : nA;
+		int nQ = pair._swapped ? nA : nB;
+		double * p = _work.data();
+		double * q = p + (3 * nP);
+		std::copy(_points.begin() + pair._offset, _points.begin() + pair._offset + (3 * (nP + nQ)), p);
+		_points.resize(pair._offset);
+
+		// Discard the pair if the bounding boxes of its parts are disjoint
+		double boxP[4], boxQ[4];
+		BoundingBox(p, nP, boxP);
+		BoundingBox(q, nQ, boxQ);
+		if (boxP[0] > boxQ[2] || boxQ[0] > boxP[2] || boxP[1] > boxQ[3] || boxQ[1] > boxP[3])
+		{
+			continue;
+		}
+
+		// If both parts are within the tolerance (or the pair cannot be refined any more) then store the intersection
+		double pLength = pair._p1 - pair._p0;
+		double qLength = pair._q1 - pair._q0;
+		if ((pLength <= _tolerance && qLength <= _tolerance) || pair._depth >= INTERSECTION_MAX_DEPTH)
+		{
+			double t = 0.5 * (pair._p0 + pair._p1);
+			double u = 0.5 * (pair._q0 + pair._q1);
+			_found.push_back(pair._swapped ? std::make_pair(u, t) : std::make_pair(t, u));
+			continue;
+		}
+
+		// Clip the part against the fat line of the other one, if nothing is left then there is no intersection
+		double tMin = 0.0;
+		double tMax = 1.0;
+		if (clipping && !Clip(p, nP, q, nQ, tMin, tMax))
+		{
+			continue;
+		}
+
+		// Keep the clipped interval of the part
+		if (tMax < 1.0)
+		{
+			KeepLeft(p, nP, tMax);
+		}
+		if (tMin > 0.0)
+		{
+			KeepRight(p, nP, tMin / tMax);
+		}
+		double p0 = pair._p0 + (tMin * pLength);
+		double p1 = pair._p0 + (tMax * pLength);
+
+		// If the clipping kept most of the interval then split the longest part in half (there may be many intersections)
+		if (tMax - tMin > INTERSECTION_SPLIT_RATIO)
+		{
+			double * halves = q + (3 * nQ);
+			if (p1 - p0 >= qLength)
+			{
+				double * right = halves + (3 * nP);
+				std::copy(p, p + (3 * nP), halves);
+				std::copy(p, p + (3 * nP), right);
+				KeepLeft(halves, nP, 0.5);
+				KeepRight(right, nP, 0.5);
+				double middle = 0.5 * (p0 + p1);
+				PushPair(right, nP, q, nQ, middle, p1, pair._q0, pair._q1, pair._depth + 1, pair._swapped);
+				PushPair(halves, nP, q, nQ, p0, middle, pair._q0, pair._q1, pair._depth + 1, pair._swapped);
+			}
+			else
+			{
+				double * right = halves + (3 * nQ);
+				std::copy(q, q + (3 * nQ), halves);
+				std::copy(q, q + (3 * nQ), right);
+				KeepLeft(halves, nQ, 0.5);
+				KeepRight(right, nQ, 0.5);
+				double middle = 0.5 * (pair._q0 + pair._q1);
+				PushPair(p, nP, right, nQ, p0, p1, middle, pair._q1, pair._depth + 1, pair._swapped);
+				PushPair(p, nP, halves, nQ, p0, p1, pair._q0, middle, pair._depth + 1, pair._swapped);
+			}
+			continue;
+		}
+
+		// Otherwise swap the roles of the parts, so the other one is clipped next
+		PushPair(q, nQ, p, nP, pair._q0, pair._q1, p0, p1, pair._depth + 1, !pair._swapped);
+	}
+
+	// Sort the parameters and remove the duplicates (an intersection on the border of two parts is found by both)
+	std::sort(_found.begin(), _found.end());
+	double mergeDistance = 1e3 * _tolerance;
+	int nFound = 0;
+	int nFoundTotal = _found.size();
+	for (int i = 0; i < nFoundTotal; i += 1)
+	{
+		if (nFound > 0 &&
+			std::fabs(_found[i].first - out.back().first) <= mergeDistance &&
+			std::fabs(_found[i].second - out.back().second) <= mergeDistance)
+		{
+			continue;
+		}
+
+		out.push_back(_found[i]);
+		nFound += 1;
+	}
+
+	// Return the number of intersections found
+	return nFound;
+}
+
+std::vector<CurveIntersection> * CurveIntersector::IntersectAll(std::vector<BezierCurve *> * curves, ThreadPool * pool)
+{
+	// Get the number of curves
+	int nCurves = curves->size();
+
+	// Get the tight bounding box of every curve with at least two control points (cached by the curves)
+	std::vector<double> boxes(4 * nCurves);
+	std::vector<int> order;
+	order.reserve(nCurves);
+	for (int i = 0; i < nCurves; i += 1)
+	{
+		BezierCurve * curve = curves->at(i);
+		if (curve->_controlPoints->size() < 2)
+		{
+			continue;
+		}
+
+		curve->BoundingBox(boxes.data() + (4 * i));
+		order.push_back(i);
+	}
+
+	// Sort the curves by the left side of their boxes
+	std::sort(order.begin(), order.end(), [&boxes](int i, int j) { return boxes[4 * i] < boxes[4 * j]; });
+
+	// Sweep the boxes from left to right, every box is only tested against the following ones starting before its right side
+	std::vector<std::pair<int, int>> candidates;
+	int nOrder = order.size();
+	for (int k = 0; k < nOrder; k += 1)
+	{
+		const double * box = boxes.data() + (4 * order[k]);
+		for (int m = k + 1; m < nOrder && boxes[4 * order[m]] <= box[2]; m += 1)
+		{
+			const double * other = boxes.data() + (4 * order[m]);
+			if (other[1] <= box[3] && box[1] <= other[3])
+			{
+				int i = order[k];
+				int j = order[m];
+				candidates.push_back((i < j) ? std::make_pair(i, j) : std::make_pair(j, i));
+			}
+		}
+	}
+
+	// The intersections and the mutex protecting them
+	std::vector<CurveIntersection> * intersections = new std::vector<CurveIntersection>();
+	std::mutex intersectionsMutex;
+
+	// The task testing a chunk of the candidate pairs with the intersector of its thread (so its buffers are kept between chunks)
+	double tolerance = _tolerance;
+	std::function<void(int, int)> task = [&](int begin, int end)
+	{
+		static thread_local CurveIntersector intersector;
+		intersector._tolerance = tolerance;
+		std::vector<std::pair<double, double>> parameters;
+		std::vector<CurveIntersection> found;
+		for (int c = begin; c < end; c += 1)
+		{
+			int i = candidates[c].first;
+			int j = candidates[c].second;
+			parameters.clear();
+			intersector.Intersect(curves->at(i), curves->at(j), parameters);
+
+			int nParameters = parameters.size();
+			for (int k = 0; k < nParameters; k += 1)
+			{
+				Point point = curves->at(i)->Evaluate(parameters[k].first);
+				CurveIntersection intersection = { i, j, parameters[k].first, parameters[k].second, point.x, point.y };
+				found.push_back(intersection);
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(intersectionsMutex);
+		intersections->insert(intersections->end(), found.begin(), found.end());
+	};
+
+	// Run the tests on the pool, or on the calling thread if there is no pool
+	if (pool != NULL)
+	{
+		pool->ParallelFor((int)candidates.size(), INTERSECTION_PAIRS_PER_TASK, task);
+	}
+	else
+	{
+		task(0, (int)candidates.size());
+	}
+
+	// Sort the intersections, so the result does not depend on the order the tasks finished
+	std::sort(intersections->begin(), intersections->end(), [](const CurveIntersection & a, const CurveIntersection & b)
+	{
+		if (a._first != b._first)
+		{
+			return a._first < b._first;
+		}
+		if (a._second != b._second)
+		{
+			return a._second < b._second;
+		}
+		return a._t < b._t;
+	});
+
+	// Return the pointer to the intersections
+	return intersections;
+}
+
+void CurveIntersector::PushPair(const double * p, int nP, const double * q, int nQ, double p0, double p1, double q0, double q1, int depth, bool swapped)
+{
+	// Append the control points of both parts to the buffer
+	int offset = _points.size();
+	_points.insert(_points.end(), p, p + (3 * nP));
+	_points.insert(_points.end(), q, q + (3 * nQ));
+
+	// Store the pair
+	IntersectionPair pair = { p0, p1, q0, q1, depth, swapped, offset };
+	_pairs.push_back(pair);
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#ifndef _CURVE_INTERSECTOR_H_
+#define _CURVE_INTERSECTOR_H_
+
+#include "bezier_curve.h"
+#include "thread_pool.h"
+#include <utility>
+#include <vector>
+
+// The default parametric tolerance of the intersections
+const double INTERSECTION_TOLERANCE = 1e-9;
+
+// The maximum number of clipping or subdivision steps applied to a pair of curves (tangent intersections converge slowly)
+const int INTERSECTION_MAX_DEPTH = 64;
+
+// The maximum number of pairs of parts processed for a pair of curves (overlapping curves would split forever)
+const int INTERSECTION_MAX_STEPS = 1 << 16;
+
+// The number of pairs of curves tested by every task of the parallel intersection
+const int INTERSECTION_PAIRS_PER_TASK = 32;
+
+/*
+The intersection between two curves.
+*/
+struct CurveIntersection
+{
+	// The index of the first curve
+	int _first;
+
+	// The index of the second curve
+	int _second;
+
+	// The parameter of the intersection in the first curve
+	double _t;
+
+	// The parameter of the intersection in the second curve
+	double _u;
+
+	// The X coordinate of the intersection
+	double _x;
+
+	// The Y coordinate of the intersection
+	double _y;
+};
+
+/*
+A pending pair of parts of two curves. Its control points are stored in the points buffer of the intersector, first the ones of
+the part being clipped and then the ones of the part defining the fat line (X, Y and W arrays each).
+*/
+struct IntersectionPair
+{
+	// The parameter interval of the part being clipped
+	double _p0, _p1;
+
+	// The parameter interval of the part defining the fat line
+	double _q0, _q1;
+
+	// The number of steps applied so far
+	int _depth;
+
+	// Indicates whether the part being clipped belongs to the second curve
+	bool _swapped;
+
+	// The offset of the control points in the points buffer
+	int _offset;
+};
+
+/*
+The class finding the intersections between Bezier curves using Bezier clipping. The part of a curve outside of the fat line
+of the other one (the band around the line through its end points containing its control points) is cut away using the convex
+hull of its distance control points, and the curves swap roles until both parts are within the tolerance. Parts whose clipping
+does not remove enough are split in half, and parts with disjoint bounding boxes are discarded.
+NOTE: Every buffer is kept between calls, so an intersector allocates nothing once it has seen its largest curves.
+*/
+class CurveIntersector
+{
+
+public:
+
+	// The parametric tolerance of the intersections
+	double _tolerance;
+
+	// The stacked control points of the pending pairs
+	std::vector<double> _points;
+
+	// The pending pairs
+	std::vector<IntersectionPair> _pairs;
+
+	// The working copies of the control points of the current pair and their halves
+	std::vector<double> _work;
+
+	// The distance control points of the part being clipped
+	std::vector<Point> _distances;
+
+	// The vertices of the convex hull of the distance control points
+	std::vector<Point> _hull;
+
+	// The parameters found for the current pair of curves before removing duplicates
+	std::vector<std::pair<double, double>> _found;
+
+	/*
+	Constructor of the class
+	@param double tolerance The parametric tolerance of the intersections
+	*/
+	CurveIntersector(double tolerance = INTERSECTION_TOLERANCE);
+
+	/*
+	Destructor of the class
+	*/
+	~CurveIntersector();
+
+	/*
+	Finds the parameter interval of a curve inside of the fat line of another one. The distances from the control points of
+	the curve to the line are the control points of its distance function, whose convex hull is intersected with the band
+	of the fat line.
+	NOTE: If the second curve is a single point then the interval is [0, 1].
+	@param const double * p The X and Y arrays of the control points of the curve being clipped
+	@param int nP The number of control points of the curve being clipped
+	@param const double * q The X and Y arrays of the control points of the curve defining the fat line
+	@param int nQ The number of control points of the curve defining the fat line
+	@param double & tMin The left value of the interval
+	@param double & tMax The right value of the interval
+	@return bool If the interval is not empty
+	*/
+	bool Clip(const double * p, int nP, const double * q, int nQ, double & tMin, double & tMax);
+
+	/*
+	Finds the intersections between two curves.
+	NOTE: Rational curves are not clipped (their distance function is not polynomial), they are only subdivided and culled.
+	NOTE: Curves with less than two control points have no intersections. Overlapping curves stop after INTERSECTION_MAX_STEPS 
+	steps, returning the intersections found so far.
+	@param const BezierCurve * first The first curve
+	@param const BezierCurve * second The second curve
+	@param std::vector<std::pair<double, double>> & out The vector where the parameters of the intersections in the first and the
+	second curves are appended, sorted by the first parameter
+	@return int The number of intersections found
+	*/
+	int Intersect(const BezierCurve * first, const BezierCurve * second, std::vector<std::pair<double, double>> & out);
+
+	/*
+	Finds the intersections among all of the given curves. The bounding boxes of the control points are sorted along the X axis
+	and swept so only pairs of overlapping boxes are tested, and the tests are split among the threads of the pool. Every thread
+	keeps its own intersector, so the buffers of the clipping are reused by all of the tests it runs.
+	@param std::vector<BezierCurve *> * curves The curves
+	@param ThreadPool * pool The pool running the tests (NULL runs them on the calling thread)
+	@return std::vector<CurveIntersection> * The pointer to the vector with the intersections, sorted by the indices of their
+	curves and their parameters
+	*/
+	std::vector<CurveIntersection> * IntersectAll(std::vector<BezierCurve *> * curves, ThreadPool * pool);
+
+	/*
+	Stores a new pending pair.
+	@param const double * p The control points of the part being clipped (X, Y and W arrays)
+	@param int nP The number of control points of the part being clipped
+	@param const double * q The control points of the part defining the fat line (X, Y and W arrays)
+	@param int nQ The number of control points of the part defining the fat line
+	@param double p0 The left value of the parameter interval of the part being clipped
+	@param double p1 The right value of the parameter interval of the part being clipped
+	@param double q0 The left value of the parameter interval of the part defining the fat line
+	@param double q1 The right value of the parameter interval of the part defining the fat line
+	@param int depth The number of steps applied so far
+	@param bool swapped If the part being clipped belongs to the second curve
+	*/
+	void PushPair(const double * p, int nP, const double * q, int nQ, double p0, double p1, double q0, double q1, int depth, bool swapped);
+
+};
+
+#endif
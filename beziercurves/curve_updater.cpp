@@ -0,0 +1,185 @@
+#include "curve_updater.h"
+#include "simd.h"
+#include <cmath>
+
+/*
+Indicates whether the curve points of a curve are calculated with the shared Bernstein basis matrix (see BezierCurve::Sample).
+@param const BezierCurve * curve The curve
+@return bool If the curve uses the basis matrix
+*/
+static bool UsesBasis(const BezierCurve * curve)
+{
+	return curve->_tessellationMode == TESSELLATION_DECASTELJAU || (curve->_tessellationMode == TESSELLATION_FORWARD_DIFFERENCES && curve->_rational);
+}
+
+CurveUpdater::CurveUpdater()
+{
+}
+
+CurveUpdater::~CurveUpdater()
+{
+}
+
+void CurveUpdater::AddItems(BezierCurve * curve, int index, bool tessellate, int segments, int nTicks, bool arcLength)
+{
+	// Get the number of control points and curve points
+	int nPoints = curve->_controlPoints->size();
+	int nCurvePoints = segments + 1;
+
+	// Add the curve points of the curve
+	if (tessellate)
+	{
+		// Estimate the cost of the curve points (every one of them combines every control point)
+		double cost = (double)nPoints * (double)nCurvePoints * (curve->_rational ? 1.5 : 1.0);
+
+		// Curves using the basis matrix are split into pieces of about the same cost, the others are tessellated at once
+		if (UsesBasis(curve))
+		{
+			// Get the number of curve points per piece (a multiple of the SIMD width)
+			int nPieces = (int)std::ceil(cost / CURVE_UPDATE_PIECE_COST);
+			int pieceRows = (nCurvePoints + nPieces - 1) / nPieces;
+			pieceRows = ((pieceRows + Simd::LANES - 1) / Simd::LANES) * Simd::LANES;
+
+			// Add the pieces
+			for (int first = 0; first < nCurvePoints; first += pieceRows)
+			{
+				int last = (first + pieceRows < nCurvePoints) ? first + pieceRows : nCurvePoints;
+				CurveUpdateItem item = { CURVE_UPDATE_PIECE, index, first, last };
+				_items.push_back(item);
+				_costs.push_back((cost * (last - first)) / nCurvePoints);
+			}
+		}
+		else
+		{
+			CurveUpdateItem item = { CURVE_UPDATE_TESSELLATION, index, 0, nCurvePoints };
+			_items.push_back(item);
+			_costs.push_back(cost);
+		}
+	}
+
+	// Estimate the cost of the details: the hull sorts the control points, every tick and the reparametrized point run
+	// DeCasteljau's algorithm, and the ticks at equal arc lengths integrate the speed of the curve
+	double n = (double)nPoints;
+	double cost = (n * std::log(n + 1.0)) + (((double)nTicks + 2.0) * n * n);
+	if (arcLength)
+	{
+		cost += (5.0 * ARC_LENGTH_INTERVALS + (double)nTicks * ARC_LENGTH_MAX_ITERATIONS) * n * n;
+	}
+
+	// Add the details of the curve
+	CurveUpdateItem item = { CURVE_UPDATE_DETAILS, index, 0, 0 };
+	_items.push_back(item);
+	_costs.push_back(cost);
+}
+
+void CurveUpdater::Compute(std::vector<BezierCurve *> * curves, ThreadPool * pool, double x, double y, int segments, double flatnessTolerance, int nTicks, bool arcLength, double s, double l, double r)
+{
+	// Remove the items of the previous update
+	_items.clear();
+	_costs.clear();
+
+	// Get the number of curves
+	int nCurves = curves->size();
+	_tessellated.assign(nCurves, 0);
+
+	// Traverse through the curves
+	for (int i = 0; i < nCurves; i += 1)
+	{
+		// Get the reference to the current curve
+		BezierCurve * curve = curves->at(i);
+
+		// Check if the curve points no longer match the control points, the domain, the segments or the flatness tolerance
+		bool adaptive = curve->_tessellationMode == TESSELLATION_ADAPTIVE;
+		bool stale = curve->_curveVersion != curve->_version || curve->_lastX != x || curve->_lastY != y ||
+			(adaptive ? curve->_flatnessTolerance != flatnessTolerance : (int)curve->_curveX.size() != segments + 1);
+		_tessellated[i] = (curve->_controlPoints->size() > 1 && stale) ? 1 : 0;
+
+		// Set the flatness tolerance of the curve
+		curve->_flatnessTolerance = flatnessTolerance;
+
+		// Make room for the curve points (the pieces of a curve write to their own ranges)
+		if (_tessellated[i] && !adaptive)
+		{
+			curve->_curveX.resize(segments + 1);
+			curve->_curveY.resize(segments + 1);
+		}
+
+		// Add the items of the curve
+		AddItems(curve, i, _tessellated[i] != 0, segments, nTicks, arcLength);
+	}
+
+	// Run the items, every thread starting with items of about the same total cost
+	// NOTE: The pieces of a curve only read its control points, and the rest of the curve is only changed by its details item
+	std::function<void(int, int)> task = [&](int first, int last)
+	{
+		for (int k = first; k < last; k += 1)
+		{
+			RunItem(curves, _items[k], x, y, segments, nTicks, arcLength, s, l, r);
+		}
+	};
+	pool->ParallelFor(_items.size(), _costs.data(), task);
+
+	// Indicate the curve points of the tessellated curves match their control points, and keep the basis matrix of the ones
+	// calculated by pieces (see BezierCurve::MoveControlPoint)
+	for (int i = 0; i < nCurves; i += 1)
+	{
+		if (_tessellated[i])
+		{
+			BezierCurve * curve = curves->at(i);
+			curve->_curveVersion = curve->_version;
+			if (UsesBasis(curve))
+			{
+				curve->_basis = BernsteinBasis::Get(curve->_controlPoints->size(), x, y, segments);
+			}
+		}
+	}
+}
+
+void CurveUpdater::RunItem(std::vector<BezierCurve *> * curves, const CurveUpdateItem & item, double x, double y, int segments, int nTicks, bool arcLength, double s, double l, double r)
+{
+	// Get the reference to the curve of the item
+	BezierCurve * curve = curves->at(item._curve);
+
+	switch (item._kind)
+	{
+	case CURVE_UPDATE_PIECE:
+		// Calculate the range of curve points
+		curve->SampleRange(x, y, segments, item._first, item._last, curve->_curveX.data(), curve->_curveY.data());
+		break;
+
+	case CURVE_UPDATE_TESSELLATION:
+		// Calculate every curve point
+		curve->Tessellate(x, y, segments);
+		break;
+
+	case CURVE_UPDATE_DETAILS:
+		// Calculate the convex hull, the ticks and the reparametrized point
+		curve->ConvexHull();
+		curve->ComputeTicks(nTicks, arcLength);
+		curve->ComputeSPoint(s, l, r);
+		break;
+	}
+}
+
+void CurveUpdater::Upload(std::vector<BezierCurve *> * curves, double x, double y)
+{
+	// Get the number of curves
+	int nCurves = curves->size();
+
+	// Traverse through the curves
+	for (int i = 0; i < nCurves; i += 1)
+	{
+		// Get the reference to the current curve
+		BezierCurve * curve = curves->at(i);
+
+		// Redefine the geometry of the curves whose curve points were calculated (and the ones without curve points)
+		if (_tessellated[i] || curve->_controlPoints->size() < 2)
+		{
+			curve->UpdateGeometry(x, y);
+		}
+
+		// Redefine the ticks and the reparametrized point
+		curve->UploadTicks();
+		curve->UploadSPoint();
+	}
+}
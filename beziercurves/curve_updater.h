@@ -0,0 +1,131 @@
+#pragma once
+
+#ifndef _CURVE_UPDATER_H_
+#define _CURVE_UPDATER_H_
+
+#include "bezier_curve.h"
+#include "thread_pool.h"
+#include <vector>
+
+// The estimated cost of every piece the curve points of a single curve are split into (control points times curve points)
+const double CURVE_UPDATE_PIECE_COST = 16384.0;
+
+/*
+The kind of work of a curve update item.
+*/
+enum CurveUpdateKind
+{
+	// A range of the curve points of a curve calculated with the shared Bernstein basis matrix (see BezierCurve::SampleRange)
+	CURVE_UPDATE_PIECE,
+
+	// Every curve point of a curve (forward differences and adaptive tessellation cannot be split)
+	CURVE_UPDATE_TESSELLATION,
+
+	// The convex hull, the ticks and the reparametrized point of a curve
+	CURVE_UPDATE_DETAILS
+};
+
+/*
+A piece of work of the update of the curves.
+*/
+struct CurveUpdateItem
+{
+	// The kind of work
+	CurveUpdateKind _kind;
+
+	// The index of the curve
+	int _curve;
+
+	// The first curve point of the piece
+	int _first;
+
+	// The last curve point of the piece (exclusive)
+	int _last;
+};
+
+/*
+The class updating every curve of the scene at once. The work is split into items (pieces of the curve points, whole
+tessellations and the remaining details of every curve) whose costs are estimated from the degree of the curves, so a few
+high degree curves are split among the threads instead of keeping one of them busy. The items are run by a thread pool
+(see Compute), and the results are uploaded afterwards by the thread owning the OpenGL context (see Upload).
+*/
+class CurveUpdater
+{
+
+public:
+
+	// The items of the last update
+	std::vector<CurveUpdateItem> _items;
+
+	// The estimated cost of every item
+	std::vector<double> _costs;
+
+	// Indicates for every curve whether its curve points were calculated by the last update
+	std::vector<char> _tessellated;
+
+	/*
+	Constructor of the class
+	*/
+	CurveUpdater();
+
+	/*
+	Destructor of the class
+	*/
+	~CurveUpdater();
+
+	/*
+	Adds the items of a curve to the update.
+	@param BezierCurve * curve The curve
+	@param int index The index of the curve
+	@param bool tessellate If the curve points of the curve have to be calculated
+	@param int segments The number of segments of the curves
+	@param int nTicks The number of ticks of the curves
+	@param bool arcLength If the ticks are placed at equal arc lengths
+	*/
+	void AddItems(BezierCurve * curve, int index, bool tessellate, int segments, int nTicks, bool arcLength);
+
+	/*
+	Calculates the curve points (only of the curves whose control points, domain, number of segments or flatness tolerance
+	changed), the convex hull, the ticks and the reparametrized point of every curve using the given pool. No OpenGL function
+	is called, so the drawables are left as they are until Upload is called.
+	@param std::vector<BezierCurve *> * curves The curves
+	@param ThreadPool * pool The pool running the items
+	@param double x The left value of the parameter domain
+	@param double y The right value of the parameter domain
+	@param int segments The number of segments of the curves
+	@param double flatnessTolerance The flatness tolerance of the curves using the adaptive tessellation
+	@param int nTicks The number of ticks of the curves
+	@param bool arcLength If the ticks are placed at equal arc lengths
+	@param double s The reparametrized parameter
+	@param double l The left boundary of the reparametrized domain
+	@param double r The right boundary for the reparametrized domain
+	*/
+	void Compute(std::vector<BezierCurve *> * curves, ThreadPool * pool, double x, double y, int segments, double flatnessTolerance, int nTicks, bool arcLength, double s, double l, double r);
+
+	/*
+	Runs a single item of the update.
+	@param std::vector<BezierCurve *> * curves The curves
+	@param const CurveUpdateItem & item The item
+	@param double x The left value of the parameter domain
+	@param double y The right value of the parameter domain
+	@param int segments The number of segments of the curves
+	@param int nTicks The number of ticks of the curves
+	@param bool arcLength If the ticks are placed at equal arc lengths
+	@param double s The reparametrized parameter
+	@param double l The left boundary of the reparametrized domain
+	@param double r The right boundary for the reparametrized domain
+	*/
+	void RunItem(std::vector<BezierCurve *> * curves, const CurveUpdateItem & item, double x, double y, int segments, int nTicks, bool arcLength, double s, double l, double r);
+
+	/*
+	Updates the drawables of the curves with the results of the last call to Compute.
+	NOTE: It must be called by the thread owning the OpenGL context.
+	@param std::vector<BezierCurve *> * curves The curves
+	@param double x The left value of the parameter domain
+	@param double y The right value of the parameter domain
+	*/
+	void Upload(std::vector<BezierCurve *> * curves, double x, double y);
+
+};
+
+#endif
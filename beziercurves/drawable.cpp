@@ -1,14 +1,14 @@
 #include "drawable.h"
 #include <glm/gtc/type_ptr.hpp>
-#include <iostream>
 
 Drawable::Drawable() :
 	_drawing(true), 
 	_vertexAttributesInitialized(false), 
-	_vao(-1),
-	_vbo(-1),
-	_ebo(-1),
-	_shaderProgram(-1),
+	_vao(0),
+	_vbo(0),
+	_vboCapacity(0),
+	_program(NULL),
+	_shaderProgram(0),
 	_modelMatrixLocation(-1),
 	_viewMatrixLocation(-1),
 	_projectionMatrixLocation(-1),
@@ -20,9 +20,21 @@ Drawable::Drawable() :
 
 Drawable::~Drawable()
 {
-	// Delete the shader program
-	glUseProgram(0);
-	glDeleteProgram(_shaderProgram);
+	// Delete the vertex buffer object and the vertex array object (if they were generated, 0 is never a generated name)
+	if (_vbo != 0)
+	{
+		glDeleteBuffers(1, &_vbo);
+	}
+	if (_vao != 0)
+	{
+		glDeleteVertexArrays(1, &_vao);
+	}
+
+	// Release the shared shader program
+	ShaderProgram::Release(_program);
+
+	// Delete the color
+	delete _color;
 }
 
 bool Drawable::IsDrawing()
@@ -45,55 +57,96 @@ void Drawable::ToggleDrawing()
 	_drawing = !_drawing;
 }
 
-GLuint Drawable::GetShader(const char * source, GLenum type)
+void Drawable::GenerateShaderProgram(const char * vertexShaderCode, const char * fragmentShaderCode)
 {
-	// Create the shader
-	GLuint shader = glCreateShader(type);
+	// Get the shared program before releasing the previous one (so the same program is not linked again)
+	ShaderProgram * program = ShaderProgram::Acquire(vertexShaderCode, fragmentShaderCode);
+	ShaderProgram::Release(_program);
+	_program = program;
+
+	// Store the identifier of the shader program
+	_shaderProgram = _program->_program;
+
+	// Store the locations of the variables of the shader program
+	_pointLocation = _program->_pointLocation;
+	_modelMatrixLocation = _program->_modelMatrixLocation;
+	_viewMatrixLocation = _program->_viewMatrixLocation;
+	_projectionMatrixLocation = _program->_projectionMatrixLocation;
+	_colorLocation = _program->_colorLocation;
+}
 
-	// Set the shader source
-	glShaderSource(shader, 1, &source, NULL);
+void Drawable::DefineVertices(std::vector<Point *> * points)
+{
+	// Get the number of points and coordinates (3 coordinates per point)
+	int nPoints = points->size();
+	int nCoordinates = nPoints * 3;
 
-	// Compile the shader
-	glCompileShader(shader);
+	// Generate the VAO (if it hasn't yet)
+	if (_vao == 0)
+	{
+		glGenVertexArrays(1, &_vao);
+	}
 
-	// Get the compile status
-	GLint status = 0;
-	glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+	// Bind the VAO
+	glBindVertexArray(_vao);
 
-	// If there was a problem during compilation then post it on console
-	if (status != GL_TRUE)
+	// Generate the VBO (if it hasn't yet)
+	if (_vbo == 0)
 	{
-		// Get the error message
-		char buffer[512];
-		glGetShaderInfoLog(shader, 512, NULL, buffer);
-
-		// Write the error message
-		std::cout << "Error while compiling the shader: " << std::endl << buffer << std::endl;
+		glGenBuffers(1, &_vbo);
 	}
 
-	// Return the shader identifier
-	return shader;
-}
-
-void Drawable::GenerateShaderProgram(const char * vertexShaderCode, const char * fragmentShaderCode)
-{
-	// Define the vertex shader
-	GLuint vertexShader = GetShader(vertexShaderCode, GL_VERTEX_SHADER);
+	// Bind the VBO
+	glBindBuffer(GL_ARRAY_BUFFER, _vbo);
 
-	// Define the fragment shader
-	GLuint fragmentShader = GetShader(fragmentShaderCode, GL_FRAGMENT_SHADER);
+	// Store the coordinates, keeping the range of the ones that changed (the ones after the previous vertices always change)
+	int nPrevious = _vertices.size();
+	_vertices.resize(nCoordinates);
+	int first = nCoordinates;
+	int last = 0;
+	for (int i = 0; i < nPoints; i += 1)
+	{
+		// Get the reference to the current point
+		Point * p = points->at(i);
+
+		// Store the coordinates of the current vertex
+		GLfloat coordinates[3] = { (GLfloat)p->x, (GLfloat)p->y, (GLfloat)p->z };
+		for (int k = 0; k < 3; k += 1)
+		{
+			int index = (i * 3) + k;
+			if (index >= nPrevious || _vertices[index] != coordinates[k])
+			{
+				_vertices[index] = coordinates[k];
+				first = (index < first) ? index : first;
+				last = index + 1;
+			}
+		}
+	}
 
-	// Initialize the shader program
-	_shaderProgram = glCreateProgram();
+	// If the VBO is too small then allocate it again (at least doubling its capacity) and upload every coordinate, otherwise
+	// upload only the changed ones
+	GLsizeiptr size = nCoordinates * sizeof(GLfloat);
+	if (size > _vboCapacity)
+	{
+		_vboCapacity = (size > 2 * _vboCapacity) ? size : 2 * _vboCapacity;
+		glBufferData(GL_ARRAY_BUFFER, _vboCapacity, NULL, GL_DYNAMIC_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, size, _vertices.data());
+	}
+	else if (first < last)
+	{
+		glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(GLfloat), (last - first) * sizeof(GLfloat), _vertices.data() + first);
+	}
 
-	// Attach both the vertex shader and the fragment shader to the shader program
-	glAttachShader(_shaderProgram, vertexShader);
-	glAttachShader(_shaderProgram, fragmentShader);
+	// Initialize the vertex attribute (if it hasn't yet)
+	if (!_vertexAttributesInitialized)
+	{
+		// Enable the vertex array for passing the vertices to the shader
+		glEnableVertexAttribArray(_pointLocation);
 
-	// Link the shader program
-	glLinkProgram(_shaderProgram);
+		// Set up the specifications of the vertex array
+		glVertexAttribPointer(_pointLocation, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), 0);
 
-	// Delete shaders (we don't need them anymore since the shader program is already built)
-	glDeleteShader(vertexShader);
-	glDeleteShader(fragmentShader);
+		// Indicate the vertex attribute has been initialized
+		_vertexAttributesInitialized = true;
+	}
 }
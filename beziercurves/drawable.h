@@ -6,6 +6,8 @@
 #include <GL/gl3w.h>
 #include <glm/mat4x4.hpp>
 #include "point.h"
+#include "shader_program.h"
+#include <vector>
 
 /*
 The abstract class for any element to be rendered in the window
@@ -27,8 +29,14 @@ public:
 	// The identifier for the vertex buffer object
 	GLuint _vbo;
 
-	// The identifier for the element buffer object
-	GLuint _ebo;
+	// The number of bytes allocated for the vertex buffer object
+	GLsizeiptr _vboCapacity;
+
+	// The coordinates of the vertices stored in the vertex buffer object (3 coordinates per vertex)
+	std::vector<GLfloat> _vertices;
+
+	// The shared shader program of the element
+	ShaderProgram * _program;
 
 	// The identifier to the shader program
 	GLuint _shaderProgram;
@@ -60,7 +68,7 @@ public:
 	/*
 	Destructor of the class
 	*/
-	~Drawable();
+	virtual ~Drawable();
 
 	/*
 	Indicates whether the drawing is enabled or disabled for the element
@@ -89,19 +97,21 @@ public:
 	void ToggleDrawing();
 
 	/*
-	Defines a shader and returns its identifier
-	@param const char * source The source code of the shader
-	@param GLenum type The requested type (GL_VERTEX_SHADER or GL_FRAGMENT_SHADER)
-	*/
-	GLuint GetShader(const char * source, GLenum type);
-
-	/*
-	Defines the shader program for th given vertex and fragment shader codes
+	Sets the shader program for the given vertex and fragment shader codes. The program and the locations of its variables are
+	shared by every element using the same codes (see ShaderProgram), so it is only compiled for the first one.
 	@param const char * vertexShaderCode The source code of the vertex shader
 	@param const char * fragmentShader Code The source code of the fragment shader
 	*/
 	void GenerateShaderProgram(const char * vertexShaderCode, const char * fragmentShaderCode);
 
+	/*
+	Stores the given points in the vertex buffer object. The buffer only grows (doubling its capacity), and otherwise only the
+	range of coordinates that changed since the last call is uploaded with glBufferSubData, so moving a single point streams a
+	single vertex.
+	@param std::vector<Point *> * points The points
+	*/
+	void DefineVertices(std::vector<Point *> * points);
+
 	/*
 	Defines the shader for the element
 	*/
@@ -3,7 +3,8 @@
 #include <glm/gtc/type_ptr.hpp>
 
 DrawableLines::DrawableLines() : 
-	_totalElements(0)
+	_totalElements(0), 
+	_mode(GL_LINES)
 {
 	// Defines the shader program
 	DefineShaderProgram();
@@ -20,190 +21,28 @@ void DrawableLines::DefineGeometry()
 
 void DrawableLines::DefinePairsGeometry(std::vector<Point*>* points)
 {
-	// Get the number of points
-	int nPoints = points->size();
+	// Store the points in the VBO
+	DefineVertices(points);
 
-	// Initialize the array where the line points are stored (nPoints points x 3 coordinates per point)
-	GLfloat * vertices = new GLfloat[nPoints * 3];
-
-	// Traverse through the points
-	for (int i = 0; i < nPoints; i += 1)
-	{
-		// Get the reference to the current point
-		Point * p = points->at(i);
-
-		// Define the index for the current point in the vertices array
-		int index = i * 3;
-
-		// Store the current vertex
-		vertices[index + 0] = (GLfloat)p->x;
-		vertices[index + 1] = (GLfloat)p->y;
-		vertices[index + 2] = (GLfloat)p->z;
-	}
-
-	// Calculate the number of elements of the curve (nPoints / 2 lines X 2 points per line)
-	_totalElements = nPoints;
-
-	// Define the elements array for defining the lines of the curve 
-	GLuint * elements = new GLuint[_totalElements];
-
-	//
-	for (int i = 0; i < nPoints; i += 1)
-	{
-		// Store the line elements
-		elements[i] = i;
-	}
-
-	// Generate the VAO (if it hasn't yet)
-	if (_vao == -1)
-	{
-		glGenVertexArrays(1, &_vao);
-	}
-
-	// Bind the VAO
-	glBindVertexArray(_vao);
-
-	// Generate the VBO (if it hasn't yet)
-	if (_vbo == -1)
-	{
-		glGenBuffers(1, &_vbo);
-	}
-
-	// Bind and fill the VBO
-	glBindBuffer(GL_ARRAY_BUFFER, _vbo);
-	glBufferData(GL_ARRAY_BUFFER, nPoints * 3 * sizeof(GLfloat), vertices, GL_STATIC_DRAW);
-
-	// Generate the EBO (if it hasn't yet)
-	if (_ebo == -1)
-	{
-		glGenBuffers(1, &_ebo);
-	}
-
-	// Bind and fill the EBO
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, _totalElements * sizeof(GLuint), elements, GL_STATIC_DRAW);
-
-	// Initialize the vertex attribute (if it hasn't yet)
-	if (!_vertexAttributesInitialized)
-	{
-		// Enable the vertex array for passing the vertices to the shader
-		glEnableVertexAttribArray(_pointLocation);
-
-		// Set up the specifications of the vertex array
-		glVertexAttribPointer(_pointLocation, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), 0);
-
-		// Indicate the vertex attribute has been initialized
-		_vertexAttributesInitialized = true;
-	}
-
-	// Delete the vertices and elements array (we don't need them anymore)
-	delete vertices;
-	delete elements;
+	// Every pair of points is a line (no element buffer is needed)
+	_totalElements = points->size();
+	_mode = GL_LINES;
 }
 
 void DrawableLines::DefineSequenceGeometry(std::vector<Point*>* points)
 {
-	// Get the number of points
-	int nPoints = points->size();
-
-	// Initialize the array where the line points are stored (nPoints points x 3 coordinates per point)
-	GLfloat * vertices = new GLfloat[nPoints * 3];
-
-	// Traverse through the points
-	for (int i = 0; i < nPoints; i += 1)
-	{
-		// Get the reference to the current point
-		Point * p = points->at(i);
-
-		// Define the index for the current point in the vertices array
-		int index = i * 3;
-
-		// Store the current vertex
-		vertices[index + 0] = (GLfloat)p->x;
-		vertices[index + 1] = (GLfloat)p->y;
-		vertices[index + 2] = (GLfloat)p->z;
-	}
-
-	// Calculate the number of elements of the curve (nPoints - 1 lines X 2 points per line)
-	_totalElements = (nPoints - 1) * 2;
-
-	// Define the elements array for defining the lines of the curve 
-	GLuint * elements = new GLuint[_totalElements];
-
-	//
-	for (int i = 0; i < nPoints - 1; i += 1)
-	{
-		// Define the index for the current line elements
-		int index = i * 2;
-
-		// Store the line elements
-		elements[index + 0] = i;
-		elements[index + 1] = i + 1;
-	}
-
-	// Generate the VAO (if it hasn't yet)
-	if (_vao == -1)
-	{
-		glGenVertexArrays(1, &_vao);
-	}
-
-	// Bind the VAO
-	glBindVertexArray(_vao);
+	// Store the points in the VBO
+	DefineVertices(points);
 
-	// Generate the VBO (if it hasn't yet)
-	if (_vbo == -1)
-	{
-		glGenBuffers(1, &_vbo);
-	}
-
-	// Bind and fill the VBO
-	glBindBuffer(GL_ARRAY_BUFFER, _vbo);
-	glBufferData(GL_ARRAY_BUFFER, nPoints * 3 * sizeof(GLfloat), vertices, GL_STATIC_DRAW);
-
-	// Generate the EBO (if it hasn't yet)
-	if (_ebo == -1)
-	{
-		glGenBuffers(1, &_ebo);
-	}
-
-	// Bind and fill the EBO
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, _totalElements * sizeof(GLuint), elements, GL_STATIC_DRAW);
-
-	// Initialize the vertex attribute (if it hasn't yet)
-	if (!_vertexAttributesInitialized)
-	{
-		// Enable the vertex array for passing the vertices to the shader
-		glEnableVertexAttribArray(_pointLocation);
-
-		// Set up the specifications of the vertex array
-		glVertexAttribPointer(_pointLocation, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), 0);
-
-		// Indicate the vertex attribute has been initialized
-		_vertexAttributesInitialized = true;
-	}
-
-	// Delete the vertices and elements array (we don't need them anymore)
-	delete vertices;
-	delete elements;
+	// Every point is joined to the next one (no element buffer is needed)
+	_totalElements = points->size();
+	_mode = GL_LINE_STRIP;
 }
 
 void DrawableLines::DefineShaderProgram()
 {
 	// Generate the shader program
 	GenerateShaderProgram(Shaders::basicVertexShaderSource, Shaders::basicFragmentShaderSource);
-
-	// Specify the fragment shader output will be located in the default buffer (AKA 0)
-	glBindFragDataLocation(_shaderProgram, 0, "outColor");
-
-	// Get the identifier for the location of the point input variable of the shader
-	_pointLocation = glGetAttribLocation(_shaderProgram, "point");
-
-	// Get the location of the uniform variables in the shader program
-	_modelMatrixLocation = glGetUniformLocation(_shaderProgram, "modelMatrix");
-	_viewMatrixLocation = glGetUniformLocation(_shaderProgram, "viewMatrix");
-	_projectionMatrixLocation = glGetUniformLocation(_shaderProgram, "projMatrix");
-	_colorLocation = glGetUniformLocation(_shaderProgram, "color");
 }
 
 void DrawableLines::Draw(const glm::mat4 model, const glm::mat4 view, const glm::mat4 projection)
@@ -229,5 +68,5 @@ void DrawableLines::Draw(const glm::mat4 model, const glm::mat4 view, const glm:
 	glUniformMatrix4fv(_projectionMatrixLocation, 1, GL_FALSE, glm::value_ptr(projection));
 
 	// Draw the lines
-	glDrawElements(GL_LINES, _totalElements, GL_UNSIGNED_INT, 0);
+	glDrawArrays(_mode, 0, _totalElements);
 }
@@ -13,9 +13,12 @@ class DrawableLines : public Drawable
 {
 public:
 
-	// The number of elements to be drawn
+	// The number of vertices to be drawn
 	int _totalElements;
 
+	// The primitive used for drawing the vertices (GL_LINES for pairs of points, GL_LINE_STRIP for sequences)
+	GLenum _mode;
+
 	/*
 	Constructor of the class
 	*/
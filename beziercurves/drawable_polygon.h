@@ -13,7 +13,7 @@ class DrawablePolygon : public Drawable
 {
 public:
 
-	// The number of elements for drawing the polygon
+	// The number of vertices of the polygon
 	int _totalElements;
 
 	/*
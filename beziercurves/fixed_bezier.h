@@ -0,0 +1,238 @@
+#pragma once
+
+#ifndef _FIXED_BEZIER_H_
+#define _FIXED_BEZIER_H_
+
+#include <cstddef>
+#include <utility>
+
+// The maximum number of control points with a fixed degree kernel
+const int FIXED_BEZIER_MAX_POINTS = 8;
+
+/*
+Returns the binomial coefficient (n k). It is evaluated at compile time when n and k are constants.
+@param int n
+@param int k
+@return int The binomial coefficient
+*/
+constexpr int FixedBinomial(int n, int k)
+{
+	return (k < 0 || k > n) ? 0 : ((k == 0) ? 1 : (FixedBinomial(n, k - 1) * (n - k + 1)) / k);
+}
+
+/*
+The row of binomial coefficients (N-1 0), (N-1 1), ..., (N-1 N-1), built at compile time.
+*/
+template<int N, typename Sequence = std::make_integer_sequence<int, N>>
+struct FixedBinomialRow;
+
+template<int N, int... I>
+struct FixedBinomialRow<N, std::integer_sequence<int, I...>>
+{
+	// The binomial coefficients of the row
+	static constexpr double _values[N] = { (double)FixedBinomial(N - 1, I)... };
+};
+
+template<int N, int... I>
+constexpr double FixedBinomialRow<N, std::integer_sequence<int, I...>>::_values[N];
+
+/*
+The class representing a Bezier curve with N control points of Dim coordinates each, known at compile time.
+All of the loops have compile-time bounds, so the compiler fully unrolls them and keeps the control points in registers.
+*/
+template<int N, int Dim, typename Scalar>
+class FixedBezier
+{
+
+public:
+
+	static_assert(N > 0, "A Bezier curve requires at least one control point");
+
+	// The control points of the curve
+	Scalar _points[N][Dim];
+
+	/*
+	Loads the control points from arrays of coordinates (one array per dimension).
+	@param const T * const * coordinates The arrays of coordinates, each one with at least N values
+	*/
+	template<typename T>
+	void Load(const T * const * coordinates)
+	{
+		for (int i = 0; i < N; i += 1)
+		{
+			for (int d = 0; d < Dim; d += 1)
+			{
+				_points[i][d] = (Scalar)coordinates[d][i];
+			}
+		}
+	}
+
+	/*
+	Stores the control points into arrays of coordinates (one array per dimension).
+	@param T * const * coordinates The arrays of coordinates, each one with room for at least N values
+	*/
+	template<typename T>
+	void Store(T * const * coordinates) const
+	{
+		for (int i = 0; i < N; i += 1)
+		{
+			for (int d = 0; d < Dim; d += 1)
+			{
+				coordinates[d][i] = (T)_points[i][d];
+			}
+		}
+	}
+
+	/*
+	Evaluates the curve at parameter t using the Bernstein polynomials with compile-time binomial coefficients.
+	@param Scalar t The parameter
+	@param Scalar out[Dim] The array where the curve point is stored
+	*/
+	void Evaluate(Scalar t, Scalar out[Dim]) const
+	{
+		// Run a Horner like scheme over the Bernstein polynomials, with s = 1 - t:
+		// out = (((P0 s + C1 t P1) s + C2 t^2 P2) s + ...) + Cn t^n Pn
+		Scalar s = (Scalar)1 - t;
+		Scalar tPower = (Scalar)1;
+		for (int d = 0; d < Dim; d += 1)
+		{
+			out[d] = _points[0][d];
+		}
+		for (int i = 1; i < N; i += 1)
+		{
+			tPower *= t;
+			Scalar b = (Scalar)FixedBinomialRow<N>::_values[i] * tPower;
+			for (int d = 0; d < Dim; d += 1)
+			{
+				out[d] = (out[d] * s) + (b * _points[i][d]);
+			}
+		}
+	}
+
+	/*
+	Evaluates the curve at many parameters.
+	@param const Scalar * t The array with the parameters
+	@param size_t n The number of parameters
+	@param Scalar * const * out The arrays where the coordinates of the curve points are stored (one array per dimension)
+	*/
+	void EvaluateMany(const Scalar * t, size_t n, Scalar * const * out) const
+	{
+		Scalar point[Dim];
+		for (size_t k = 0; k < n; k += 1)
+		{
+			Evaluate(t[k], point);
+			for (int d = 0; d < Dim; d += 1)
+			{
+				out[d][k] = point[d];
+			}
+		}
+	}
+
+	/*
+	Subdivides the curve at parameter t using DeCasteljau's algorithm.
+	@param Scalar t The cutting parameter
+	@param FixedBezier & left The curve where the part from the first control point to the point at t is stored
+	@param FixedBezier & right The curve where the part from the point at t to the last control point is stored
+	*/
+	void Subdivide(Scalar t, FixedBezier & left, FixedBezier & right) const
+	{
+		// Copy the control points, the DeCasteljau triangle runs in place over them
+		Scalar points[N][Dim];
+		for (int i = 0; i < N; i += 1)
+		{
+			for (int d = 0; d < Dim; d += 1)
+			{
+				points[i][d] = _points[i][d];
+			}
+		}
+
+		// Store the first and the last control points
+		for (int d = 0; d < Dim; d += 1)
+		{
+			left._points[0][d] = points[0][d];
+			right._points[N - 1][d] = points[N - 1][d];
+		}
+
+		// Run the DeCasteljau triangle, every level adds a control point to each half
+		Scalar s = (Scalar)1 - t;
+		for (int m = N - 1; m > 0; m -= 1)
+		{
+			for (int i = 0; i < m; i += 1)
+			{
+				for (int d = 0; d < Dim; d += 1)
+				{
+					points[i][d] = (s * points[i][d]) + (t * points[i + 1][d]);
+				}
+			}
+
+			for (int d = 0; d < Dim; d += 1)
+			{
+				left._points[N - m][d] = points[0][d];
+				right._points[m - 1][d] = points[m - 1][d];
+			}
+		}
+	}
+
+	/*
+	Returns the derivative (hodograph) of the curve, a Bezier curve with N - 1 control points.
+	@return FixedBezier<N - 1, Dim, Scalar> The derivative of the curve
+	*/
+	FixedBezier<N - 1, Dim, Scalar> Derivative() const
+	{
+		FixedBezier<N - 1, Dim, Scalar> derivative;
+		for (int i = 0; i < N - 1; i += 1)
+		{
+			for (int d = 0; d < Dim; d += 1)
+			{
+				derivative._points[i][d] = (Scalar)(N - 1) * (_points[i + 1][d] - _points[i][d]);
+			}
+		}
+		return derivative;
+	}
+
+};
+
+/*
+The derivative of a curve with N control points, also defined for curves with a single control point (their derivative is
+zero, represented by a single zero control point), so templates can take the second derivative of a curve of any degree.
+*/
+template<int N, int Dim, typename Scalar>
+struct FixedDerivative
+{
+	// The type of the derivative
+	typedef FixedBezier<N - 1, Dim, Scalar> Type;
+
+	/*
+	Returns the derivative of the curve.
+	@param const FixedBezier<N, Dim, Scalar> & curve The curve
+	@return Type The derivative of the curve
+	*/
+	static Type Of(const FixedBezier<N, Dim, Scalar> & curve)
+	{
+		return curve.Derivative();
+	}
+};
+
+template<int Dim, typename Scalar>
+struct FixedDerivative<1, Dim, Scalar>
+{
+	// The type of the derivative
+	typedef FixedBezier<1, Dim, Scalar> Type;
+
+	/*
+	Returns the derivative of the curve, this is, a single zero control point.
+	@param const FixedBezier<1, Dim, Scalar> & curve The curve
+	@return Type The derivative of the curve
+	*/
+	static Type Of(const FixedBezier<1, Dim, Scalar> &)
+	{
+		Type zero;
+		for (int d = 0; d < Dim; d += 1)
+		{
+			zero._points[0][d] = (Scalar)0;
+		}
+		return zero;
+	}
+};
+
+#endif
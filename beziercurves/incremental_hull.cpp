@@ -0,0 +1,337 @@
+#include "incremental_hull.h"
+#include "utils.h"
+#include <algorithm>
+#include <cmath>
+
+/*
+Indicates whether a point is inside of a counterclockwise triangle (or on its sides).
+@param double px The X coordinate of the point
+@param double py The Y coordinate of the point
+@param double ax The X coordinate of the first vertex of the triangle
+@param double ay The Y coordinate of the first vertex of the triangle
+@param double bx The X coordinate of the second vertex of the triangle
+@param double by The Y coordinate of the second vertex of the triangle
+@param double cx The X coordinate of the third vertex of the triangle
+@param double cy The Y coordinate of the third vertex of the triangle
+@return bool If the point is inside of the triangle
+*/
+static bool InsideTriangle(double px, double py, double ax, double ay, double bx, double by, double cx, double cy)
+{
+	return Utils::IsLeft(px, py, ax, ay, bx, by) >= 0 && Utils::IsLeft(px, py, bx, by, cx, cy) >= 0 && Utils::IsLeft(px, py, cx, cy, ax, ay) >= 0;
+}
+
+/*
+Indicates whether a control point is exposed by a hull vertex being removed, this is, it is an inner control point inside of
+the triangle formed by the vertex and its neighbors.
+NOTE: Copies of the neighbors are left out so the neighbors themselves are the vertices of the patch.
+@param const ControlPoints * points The control points
+@param const std::vector<char> & onHull Indicates for every control point whether it is a vertex of the hull
+@param int i The index of the control point
+@param int u The index of the previous neighbor of the vertex
+@param int w The index of the next neighbor of the vertex
+@param double x The X coordinate of the vertex
+@param double y The Y coordinate of the vertex
+@return bool If the control point is exposed
+*/
+static bool Exposed(const ControlPoints * points, const std::vector<char> & onHull, int i, int u, int w, double x, double y)
+{
+	const ControlScalar * px = points->_x;
+	const ControlScalar * py = points->_y;
+	bool duplicate = (px[i] == px[u] && py[i] == py[u]) || (px[i] == px[w] && py[i] == py[w]);
+	return !onHull[i] && !duplicate && InsideTriangle(px[i], py[i], px[u], py[u], x, y, px[w], py[w]);
+}
+
+IncrementalHull::IncrementalHull() :
+	_grid(NULL)
+{
+}
+
+IncrementalHull::~IncrementalHull()
+{
+	delete _grid;
+}
+
+void IncrementalHull::Add(const ControlPoints * points, int index)
+{
+	// Get the coordinates of the control point
+	const ControlScalar * x = points->_x;
+	const ControlScalar * y = points->_y;
+	double px = x[index];
+	double py = y[index];
+
+	// Find the edges the control point can see (it is strictly on their right side)
+	int nHull = _hull.size();
+	_visible.resize(nHull);
+	bool anyVisible = false;
+	for (int k = 0; k < nHull; k += 1)
+	{
+		int a = _hull[k];
+		int b = _hull[(k + 1) % nHull];
+		_visible[k] = Utils::IsLeft(px, py, x[a], y[a], x[b], y[b]) < 0;
+		anyVisible = anyVisible || _visible[k];
+	}
+
+	// If the control point sees no edge then it is inside of the hull
+	if (!anyVisible)
+	{
+		return;
+	}
+
+	// Find the first and the last visible edges (the visible edges are consecutive)
+	int first = 0;
+	while (!_visible[first] || _visible[(first + nHull - 1) % nHull])
+	{
+		first += 1;
+	}
+	int last = first;
+	while (_visible[(last + 1) % nHull])
+	{
+		last = (last + 1) % nHull;
+	}
+
+	// Keep the vertices from the end of the last visible edge to the start of the first one, and close them with the point
+	_patch.clear();
+	for (int k = (last + 1) % nHull; k != first; k = (k + 1) % nHull)
+	{
+		_patch.push_back(_hull[k]);
+	}
+	_patch.push_back(_hull[first]);
+	for (int k = (first + 1) % nHull; k != (last + 1) % nHull; k = (k + 1) % nHull)
+	{
+		_onHull[_hull[k]] = 0;
+	}
+	_patch.push_back(index);
+	_onHull[index] = 1;
+
+	// Remove the neighbors of the point left collinear with it
+	while (_patch.size() >= 3)
+	{
+		int a = _patch[_patch.size() - 3];
+		int b = _patch[_patch.size() - 2];
+		if (Utils::IsLeft(px, py, x[a], y[a], x[b], y[b]) > 0)
+		{
+			break;
+		}
+		_onHull[b] = 0;
+		_patch.erase(_patch.end() - 2);
+	}
+	while (_patch.size() >= 3)
+	{
+		int b = _patch[0];
+		int c = _patch[1];
+		if (Utils::IsLeft(x[c], y[c], px, py, x[b], y[b]) > 0)
+		{
+			break;
+		}
+		_onHull[b] = 0;
+		_patch.erase(_patch.begin());
+	}
+
+	// Store the new hull
+	_hull.swap(_patch);
+}
+
+void IncrementalHull::Build(const ControlPoints * points)
+{
+	// Calculate the hull of every control point
+	int nPoints = points->size();
+	_candidates.resize(nPoints);
+	for (int i = 0; i < nPoints; i += 1)
+	{
+		_candidates[i] = i;
+	}
+	Utils::ConvexHull(points, _candidates, _hull);
+
+	// Mark the vertices of the hull
+	_onHull.assign(nPoints, 0);
+	int nHull = _hull.size();
+	for (int k = 0; k < nHull; k += 1)
+	{
+		_onHull[_hull[k]] = 1;
+	}
+
+	// Get the bounding box of the control points
+	double box[4] = { 0.0, 0.0, 0.0, 0.0 };
+	for (int i = 0; i < nPoints; i += 1)
+	{
+		double x = points->_x[i];
+		double y = points->_y[i];
+		box[0] = (i == 0 || x < box[0]) ? x : box[0];
+		box[1] = (i == 0 || y < box[1]) ? y : box[1];
+		box[2] = (i == 0 || x > box[2]) ? x : box[2];
+		box[3] = (i == 0 || y > box[3]) ? y : box[3];
+	}
+
+	// Store the control points in a grid of about one control point per cell (along the longest side of the box)
+	double side = std::max(box[2] - box[0], box[3] - box[1]);
+	double cellSize = (side > 0.0) ? side / std::ceil(std::sqrt((double)nPoints)) : 1.0;
+	delete _grid;
+	_grid = new ControlPointGrid(cellSize);
+	_grid->Build(points);
+}
+
+bool IncrementalHull::Erase(const ControlPoints * points, int index)
+{
+	// The hull must have at least three vertices
+	if (_hull.size() < 3)
+	{
+		return false;
+	}
+
+	// Remove the control point if it is a vertex of the hull
+	if (_onHull[index])
+	{
+		int position = std::find(_hull.begin(), _hull.end(), index) - _hull.begin();
+		Remove(points, position, points->_x[index], points->_y[index]);
+	}
+
+	// Remove the control point from the grid
+	_grid->Erase(index);
+
+	// Decrease the indices of the following control points
+	int nHull = _hull.size();
+	for (int k = 0; k < nHull; k += 1)
+	{
+		_hull[k] -= (_hull[k] > index) ? 1 : 0;
+	}
+	_onHull.erase(_onHull.begin() + index);
+	return true;
+}
+
+bool IncrementalHull::Move(const ControlPoints * points, int index, double previousX, double previousY)
+{
+	// The hull must have at least three vertices
+	int nHull = _hull.size();
+	if (nHull < 3)
+	{
+		return false;
+	}
+
+	// Move the control point in the grid
+	_grid->Move(index, points->_x[index], points->_y[index]);
+
+	// An inner control point only changes the hull if it moved outside of it
+	if (!_onHull[index])
+	{
+		Add(points, index);
+		return true;
+	}
+
+	// Get the neighbors of the vertex
+	int position = std::find(_hull.begin(), _hull.end(), index) - _hull.begin();
+	int u = _hull[(position + nHull - 1) % nHull];
+	int w = _hull[(position + 1) % nHull];
+	const ControlScalar * x = points->_x;
+	const ControlScalar * y = points->_y;
+
+	// If the previous position is inside of the triangle of the new one and the neighbors then no control point is exposed,
+	// otherwise patch the hull with the control points inside of the triangle of the previous position
+	if (InsideTriangle(previousX, previousY, x[u], y[u], x[index], y[index], x[w], y[w]))
+	{
+		_hull.erase(_hull.begin() + position);
+		_onHull[index] = 0;
+	}
+	else
+	{
+		Remove(points, position, previousX, previousY);
+	}
+
+	// Add the control point at its new position
+	if (_hull.size() < 3)
+	{
+		return false;
+	}
+	Add(points, index);
+	return true;
+}
+
+void IncrementalHull::Remove(const ControlPoints * points, int position, double x, double y)
+{
+	// Get the vertex and its neighbors
+	int nHull = _hull.size();
+	int u = _hull[(position + nHull - 1) % nHull];
+	int v = _hull[position];
+	int w = _hull[(position + 1) % nHull];
+	const ControlScalar * px = points->_x;
+	const ControlScalar * py = points->_y;
+
+	// Get the range of cells overlapping the triangle the vertex forms with its neighbors
+	double cellSize = _grid->_cellSize;
+	long long iMin = (long long)std::floor(std::min(x, (double)std::min(px[u], px[w])) / cellSize);
+	long long iMax = (long long)std::floor(std::max(x, (double)std::max(px[u], px[w])) / cellSize);
+	long long jMin = (long long)std::floor(std::min(y, (double)std::min(py[u], py[w])) / cellSize);
+	long long jMax = (long long)std::floor(std::max(y, (double)std::max(py[u], py[w])) / cellSize);
+
+	// Find the inner control points exposed by the vertex, this is, the ones inside of the triangle
+	_candidates.clear();
+	_candidates.push_back(u);
+	_candidates.push_back(w);
+	int nPoints = points->size();
+	if ((double)(iMax - iMin + 1) * (double)(jMax - jMin + 1) <= (double)nPoints)
+	{
+		// Check the control points of the cells overlapping the triangle
+		for (long long i = iMin; i <= iMax; i += 1)
+		{
+			for (long long j = jMin; j <= jMax; j += 1)
+			{
+				std::unordered_map<long long, std::vector<int>>::const_iterator cell = _grid->_cells.find(ControlPointGrid::CellKey(i, j));
+				if (cell == _grid->_cells.end())
+				{
+					continue;
+				}
+
+				int nIndices = cell->second.size();
+				for (int k = 0; k < nIndices; k += 1)
+				{
+					if (Exposed(points, _onHull, cell->second[k], u, w, x, y))
+					{
+						_candidates.push_back(cell->second[k]);
+					}
+				}
+			}
+		}
+	}
+	else
+	{
+		// The triangle spans more cells than there are control points, so checking every control point is cheaper
+		for (int i = 0; i < nPoints; i += 1)
+		{
+			if (Exposed(points, _onHull, i, u, w, x, y))
+			{
+				_candidates.push_back(i);
+			}
+		}
+	}
+
+	// Calculate their hull, its part from u to w (counterclockwise) replaces the vertex
+	Utils::ConvexHull(points, _candidates, _patch);
+	int nPatch = _patch.size();
+	int start = std::find(_patch.begin(), _patch.end(), u) - _patch.begin();
+	_onHull[v] = 0;
+	_hull.erase(_hull.begin() + position);
+	position = (position < (int)_hull.size()) ? position : 0;
+	for (int k = (start + 1) % nPatch; _patch[k] != w; k = (k + 1) % nPatch)
+	{
+		_hull.insert(_hull.begin() + position, _patch[k]);
+		_onHull[_patch[k]] = 1;
+		position += 1;
+	}
+}
+
+bool IncrementalHull::push_back(const ControlPoints * points)
+{
+	// Add the control point as an inner one
+	int index = points->size() - 1;
+	_onHull.push_back(0);
+
+	// The hull must have at least three vertices
+	if (_hull.size() < 3)
+	{
+		return false;
+	}
+
+	// Add the control point to the grid and to the hull
+	_grid->push_back(points->_x[index], points->_y[index]);
+	Add(points, index);
+	return true;
+}
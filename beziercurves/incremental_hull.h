@@ -0,0 +1,109 @@
+#pragma once
+
+#ifndef _INCREMENTAL_HULL_H_
+#define _INCREMENTAL_HULL_H_
+
+#include "control_point_grid.h"
+#include "control_points.h"
+#include <vector>
+
+/*
+The class maintaining the convex hull of a set of control points while single control points are added, erased or moved.
+A control point outside of the hull replaces the vertices of the hull edges it can see, and a control point inside of it
+changes nothing. A hull vertex being removed only exposes the control points inside of the triangle it forms with its
+neighbors, so only those are used for patching the hull. They are found in a grid over the control points, looking only at
+the cells overlapping the triangle, so the cost depends on the control points near the triangle rather than on all of them
+(every control point is only checked when the triangle spans more cells than there are control points, e.g. a hull with
+very few vertices). Moving a vertex outwards (its previous position ends up inside of the new hull) does not even need them.
+NOTE: The hull must have at least three vertices to be maintained, otherwise the update methods return false and the hull has
+to be built again.
+*/
+class IncrementalHull
+{
+
+public:
+
+	// The indices of the vertices of the hull in counterclockwise order
+	std::vector<int> _hull;
+
+	// Indicates for every control point whether it is a vertex of the hull
+	std::vector<char> _onHull;
+
+	// The control points exposed by the last removed vertex
+	std::vector<int> _candidates;
+
+	// The hull of the exposed control points
+	std::vector<int> _patch;
+
+	// Indicates for every hull edge whether it is seen by the control point being added
+	std::vector<char> _visible;
+
+	// The grid over the control points used for finding the ones exposed by a removed vertex
+	ControlPointGrid * _grid;
+
+	/*
+	Constructor of the class
+	*/
+	IncrementalHull();
+
+	/*
+	Destructor of the class
+	*/
+	~IncrementalHull();
+
+	/*
+	Adds a control point to the hull if it is outside of it, replacing the vertices between the edges it can see.
+	@param const ControlPoints * points The control points
+	@param int index The index of the control point (it must not be a vertex of the hull)
+	*/
+	void Add(const ControlPoints * points, int index);
+
+	/*
+	Calculates the hull of the given control points from scratch (see Utils::ConvexHull), and the grid over them with cells
+	about the size of the average spacing of the control points.
+	@param const ControlPoints * points The control points
+	*/
+	void Build(const ControlPoints * points);
+
+	/*
+	Removes a control point from the hull. The indices of the following control points are decreased by one, as in
+	ControlPoints::erase.
+	NOTE: It must be called before the control point is erased.
+	@param const ControlPoints * points The control points
+	@param int index The index of the control point
+	@return bool If the hull was updated (false if it has less than three vertices and it has to be built again)
+	*/
+	bool Erase(const ControlPoints * points, int index);
+
+	/*
+	Updates the hull after a control point is moved.
+	NOTE: It must be called after the control point is moved.
+	@param const ControlPoints * points The control points
+	@param int index The index of the control point
+	@param double previousX The X coordinate of the control point before it was moved
+	@param double previousY The Y coordinate of the control point before it was moved
+	@return bool If the hull was updated (false if it has less than three vertices and it has to be built again)
+	*/
+	bool Move(const ControlPoints * points, int index, double previousX, double previousY);
+
+	/*
+	Removes a vertex from the hull, patching it with the hull of the control points inside of the triangle formed by the vertex
+	and its neighbors (found in the cells of the grid overlapping the triangle).
+	@param const ControlPoints * points The control points
+	@param int position The position of the vertex in the hull
+	@param double x The X coordinate of the vertex (it may have been moved already)
+	@param double y The Y coordinate of the vertex
+	*/
+	void Remove(const ControlPoints * points, int position, double x, double y);
+
+	/*
+	Updates the hull after a control point is added after the others.
+	NOTE: It must be called after the control point is added.
+	@param const ControlPoints * points The control points
+	@return bool If the hull was updated (false if it has less than three vertices and it has to be built again)
+	*/
+	bool push_back(const ControlPoints * points);
+
+};
+
+#endif
@@ -0,0 +1,346 @@
+#include "shader_program.h"
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+// Indicates whether the shader binary cache is used
+static bool binaryCacheEnabled = true;
+
+// The directory where the files of the shader binary cache are stored (empty for the working directory)
+static std::string cacheDirectory;
+
+// The number of programs loaded from the shader binary cache and the number of programs compiled from their sources
+static int programsLoaded = 0;
+static int programsCompiled = 0;
+
+/*
+Returns the programs in use, indexed by their vertex and fragment shader sources.
+@return std::map<std::pair<std::string, std::string>, ShaderProgram *> & The reference to the programs
+*/
+static std::map<std::pair<std::string, std::string>, ShaderProgram *> & Programs()
+{
+	static std::map<std::pair<std::string, std::string>, ShaderProgram *> programs;
+	return programs;
+}
+
+/*
+Indicates whether the driver can store and load program binaries.
+@return bool If program binaries are supported
+*/
+static bool BinaryCacheSupported()
+{
+	// The functions must be available and the driver must support at least one binary format
+	if (glGetProgramBinary == NULL || glProgramBinary == NULL || glProgramParameteri == NULL)
+	{
+		return false;
+	}
+	GLint nFormats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &nFormats);
+	return nFormats > 0;
+}
+
+/*
+Returns the key of the binary of a program, this is, the vendor, the renderer and the version of the driver followed by the
+sources of the program.
+@param const char * vertexSource The source code of the vertex shader
+@param const char * fragmentSource The source code of the fragment shader
+@return std::string The key
+*/
+static std::string CacheKey(const char * vertexSource, const char * fragmentSource)
+{
+	// Add the driver strings (missing ones are left empty)
+	std::string key;
+	GLenum names[3] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+	for (int i = 0; i < 3; i += 1)
+	{
+		const GLubyte * value = glGetString(names[i]);
+		key += value ? (const char *)value : "";
+		key += '\n';
+	}
+
+	// Add the sources
+	key += vertexSource;
+	key += '\0';
+	key += fragmentSource;
+	return key;
+}
+
+/*
+Returns the path of the cache file of a program, named after the FNV-1a hash of its key.
+@param const std::string & key The key of the program
+@return std::string The path of the file
+*/
+static std::string CachePath(const std::string & key)
+{
+	// Hash the key
+	unsigned long long hash = 14695981039346656037ULL;
+	int nBytes = key.size();
+	for (int i = 0; i < nBytes; i += 1)
+	{
+		hash ^= (unsigned char)key[i];
+		hash *= 1099511628211ULL;
+	}
+
+	// Build the path of the file inside of the cache directory
+	std::ostringstream path;
+	path << cacheDirectory << SHADER_CACHE_PREFIX << std::hex << hash << ".bin";
+	return path.str();
+}
+
+ShaderProgram::ShaderProgram(const char * vertexSource, const char * fragmentSource) :
+	_vertexSource(vertexSource),
+	_fragmentSource(fragmentSource),
+	_program(0),
+	_references(0),
+	_fromCache(false),
+	_pointLocation(-1),
+	_modelMatrixLocation(-1),
+	_viewMatrixLocation(-1),
+	_projectionMatrixLocation(-1),
+	_colorLocation(-1)
+{
+	// Load the program from the cache, otherwise compile it and store it in the cache
+	bool useCache = binaryCacheEnabled && BinaryCacheSupported();
+	std::string key = useCache ? CacheKey(vertexSource, fragmentSource) : "";
+	std::string path = useCache ? CachePath(key) : "";
+	_fromCache = useCache && LoadBinary(path, key);
+	if (!_fromCache)
+	{
+		if (Link(vertexSource, fragmentSource) && useCache)
+		{
+			SaveBinary(path, key);
+		}
+	}
+
+	// Count where the program came from
+	programsLoaded += _fromCache ? 1 : 0;
+	programsCompiled += _fromCache ? 0 : 1;
+
+	// Get the identifier for the location of the point input variable of the shader
+	_pointLocation = glGetAttribLocation(_program, "point");
+
+	// Get the location of the uniform variables in the shader program
+	_modelMatrixLocation = glGetUniformLocation(_program, "modelMatrix");
+	_viewMatrixLocation = glGetUniformLocation(_program, "viewMatrix");
+	_projectionMatrixLocation = glGetUniformLocation(_program, "projMatrix");
+	_colorLocation = glGetUniformLocation(_program, "color");
+}
+
+ShaderProgram::~ShaderProgram()
+{
+	// Delete the shader program
+	glDeleteProgram(_program);
+}
+
+ShaderProgram * ShaderProgram::Acquire(const char * vertexSource, const char * fragmentSource)
+{
+	// Find the program for the sources, and create it if no drawable is using it
+	std::map<std::pair<std::string, std::string>, ShaderProgram *> & programs = Programs();
+	std::pair<std::string, std::string> key(vertexSource, fragmentSource);
+	std::map<std::pair<std::string, std::string>, ShaderProgram *>::iterator it = programs.find(key);
+	if (it == programs.end())
+	{
+		it = programs.insert(std::make_pair(key, new ShaderProgram(vertexSource, fragmentSource))).first;
+	}
+
+	// Add the reference of the drawable
+	it->second->_references += 1;
+	return it->second;
+}
+
+void ShaderProgram::GetCacheCounts(int & loaded, int & compiled)
+{
+	loaded = programsLoaded;
+	compiled = programsCompiled;
+}
+
+GLuint ShaderProgram::GetShader(const char * source, GLenum type)
+{
+	// Create the shader
+	GLuint shader = glCreateShader(type);
+
+	// Set the shader source
+	glShaderSource(shader, 1, &source, NULL);
+
+	// Compile the shader
+	glCompileShader(shader);
+
+	// Get the compile status
+	GLint status = 0;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+
+	// If there was a problem during compilation then post it on console
+	if (status != GL_TRUE)
+	{
+		// Get the error message
+		char buffer[512];
+		glGetShaderInfoLog(shader, 512, NULL, buffer);
+
+		// Write the error message
+		std::cout << "Error while compiling the shader: " << std::endl << buffer << std::endl;
+	}
+
+	// Return the shader identifier
+	return shader;
+}
+
+bool ShaderProgram::Link(const char * vertexSource, const char * fragmentSource)
+{
+	// Define the vertex shader
+	GLuint vertexShader = GetShader(vertexSource, GL_VERTEX_SHADER);
+
+	// Define the fragment shader
+	GLuint fragmentShader = GetShader(fragmentSource, GL_FRAGMENT_SHADER);
+
+	// Initialize the shader program (deleting the one rejected by the cache, if any)
+	if (_program != 0)
+	{
+		glDeleteProgram(_program);
+	}
+	_program = glCreateProgram();
+
+	// Attach both the vertex shader and the fragment shader to the shader program
+	glAttachShader(_program, vertexShader);
+	glAttachShader(_program, fragmentShader);
+
+	// Specify the fragment shader output will be located in the default buffer (AKA 0), it must be done before linking
+	glBindFragDataLocation(_program, 0, "outColor");
+
+	// Indicate the binary of the program will be retrieved (if the driver supports it)
+	if (glProgramParameteri != NULL)
+	{
+		glProgramParameteri(_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+
+	// Link the shader program
+	glLinkProgram(_program);
+
+	// Get the link status
+	GLint status = 0;
+	glGetProgramiv(_program, GL_LINK_STATUS, &status);
+
+	// If there was a problem during linking then post it on console
+	if (status != GL_TRUE)
+	{
+		// Get the error message
+		char buffer[512];
+		glGetProgramInfoLog(_program, 512, NULL, buffer);
+
+		// Write the error message
+		std::cout << "Error while linking the shader program: " << std::endl << buffer << std::endl;
+	}
+
+	// Delete shaders (we don't need them anymore since the shader program is already built)
+	glDeleteShader(vertexShader);
+	glDeleteShader(fragmentShader);
+
+	// Return whether the program was linked
+	return status == GL_TRUE;
+}
+
+bool ShaderProgram::LoadBinary(const std::string & path, const std::string & key)
+{
+	// Open the cache file (there is no binary if it does not exist)
+	std::ifstream file(path.c_str(), std::ios::binary);
+	if (!file)
+	{
+		return false;
+	}
+
+	// Read the key the binary was stored with, and discard the binary if it belongs to other sources or another driver
+	unsigned int keySize = 0;
+	file.read((char *)&keySize, sizeof(keySize));
+	if (!file || keySize != key.size())
+	{
+		return false;
+	}
+	std::string storedKey(keySize, '\0');
+	file.read(&storedKey[0], keySize);
+	if (!file || storedKey != key)
+	{
+		return false;
+	}
+
+	// Read the format and the binary
+	GLenum format = 0;
+	GLint length = 0;
+	file.read((char *)&format, sizeof(format));
+	file.read((char *)&length, sizeof(length));
+	if (!file || length <= 0)
+	{
+		return false;
+	}
+	std::vector<char> binary(length);
+	file.read(binary.data(), length);
+	if (!file)
+	{
+		return false;
+	}
+
+	// Load the binary into a new program
+	_program = glCreateProgram();
+	glProgramBinary(_program, format, binary.data(), length);
+
+	// The driver may reject the binary (e.g. after an update keeping the same version string)
+	GLint status = 0;
+	glGetProgramiv(_program, GL_LINK_STATUS, &status);
+	return status == GL_TRUE;
+}
+
+void ShaderProgram::Release(ShaderProgram * program)
+{
+	// If there is no program then exit the function
+	if (program == NULL)
+	{
+		return;
+	}
+
+	// Remove the reference, and delete the program if it was the last one
+	program->_references -= 1;
+	if (program->_references == 0)
+	{
+		Programs().erase(std::make_pair(program->_vertexSource, program->_fragmentSource));
+		delete program;
+	}
+}
+
+void ShaderProgram::SaveBinary(const std::string & path, const std::string & key)
+{
+	// Get the binary of the program
+	GLint length = 0;
+	glGetProgramiv(_program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+	{
+		return;
+	}
+	std::vector<char> binary(length);
+	GLenum format = 0;
+	glGetProgramBinary(_program, length, &length, &format, binary.data());
+
+	// Write the key, the format and the binary (failing to write the file only means the program is compiled next time)
+	std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+	unsigned int keySize = key.size();
+	file.write((const char *)&keySize, sizeof(keySize));
+	file.write(key.data(), keySize);
+	file.write((const char *)&format, sizeof(format));
+	file.write((const char *)&length, sizeof(length));
+	file.write(binary.data(), length);
+}
+
+void ShaderProgram::SetBinaryCache(bool enabled)
+{
+	binaryCacheEnabled = enabled;
+}
+
+void ShaderProgram::SetCacheDirectory(const std::string & directory)
+{
+	// Store the directory ending with a separator, so the names of the files can be appended to it
+	cacheDirectory = directory;
+	if (!cacheDirectory.empty() && cacheDirectory[cacheDirectory.size() - 1] != '/' && cacheDirectory[cacheDirectory.size() - 1] != '\\')
+	{
+		cacheDirectory += '/';
+	}
+}
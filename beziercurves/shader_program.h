@@ -0,0 +1,138 @@
+#pragma once
+
+#ifndef _SHADER_PROGRAM_H_
+#define _SHADER_PROGRAM_H_
+
+#include <GL/gl3w.h>
+#include <string>
+
+// The prefix of the files of the shader binary cache (followed by the hash of the program and ".bin"), stored in the cache
+// directory (see ShaderProgram::SetCacheDirectory)
+const char * const SHADER_CACHE_PREFIX = "shader_cache_";
+
+/*
+The class representing a linked shader program shared by every drawable using the same vertex and fragment shader sources.
+Programs are compiled and linked the first time they are requested, the locations of their variables are looked up once,
+and they are deleted when the last drawable using them releases them.
+Linked programs are also stored on disk (see glGetProgramBinary), so later launches load them instead of compiling the sources.
+Every binary is stored with the sources and the vendor, renderer and version of the driver, and it is only used when all of
+them match; otherwise (or if the driver rejects the binary) the sources are compiled and the binary is stored again.
+NOTE: Programs are OpenGL objects, so they must only be acquired and released by the thread owning the OpenGL context.
+*/
+class ShaderProgram
+{
+
+public:
+
+	// The source code of the vertex shader
+	std::string _vertexSource;
+
+	// The source code of the fragment shader
+	std::string _fragmentSource;
+
+	// The identifier of the shader program
+	GLuint _program;
+
+	// The number of drawables using the program
+	int _references;
+
+	// Indicates whether the program was loaded from the shader binary cache
+	bool _fromCache;
+
+	// The identifier for the location of the vertex point in the shader program
+	GLint _pointLocation;
+
+	// The identifier for the location of the model matrix in the shader program
+	GLint _modelMatrixLocation;
+
+	// The identifier for the location of the view matrix in the shader program
+	GLint _viewMatrixLocation;
+
+	// The identifier for the location of the projection matrix in the shader program
+	GLint _projectionMatrixLocation;
+
+	// The identifier for the location of the color variable in the shader program
+	GLint _colorLocation;
+
+	/*
+	Constructor of the class. Loads the program from the shader binary cache (or compiles and links it) and gets the locations
+	of its variables.
+	@param const char * vertexSource The source code of the vertex shader
+	@param const char * fragmentSource The source code of the fragment shader
+	*/
+	ShaderProgram(const char * vertexSource, const char * fragmentSource);
+
+	/*
+	Destructor of the class. Deletes the program.
+	*/
+	~ShaderProgram();
+
+	/*
+	Returns the program for the given sources, compiling and linking it if no drawable is using it yet. Every call must be
+	matched by a call to Release.
+	@param const char * vertexSource The source code of the vertex shader
+	@param const char * fragmentSource The source code of the fragment shader
+	@return ShaderProgram * The pointer to the shared program
+	*/
+	static ShaderProgram * Acquire(const char * vertexSource, const char * fragmentSource);
+
+	/*
+	Returns how many of the programs created so far were loaded from the shader binary cache and how many were compiled.
+	@param int & loaded The number of programs loaded from the cache
+	@param int & compiled The number of programs compiled from their sources
+	*/
+	static void GetCacheCounts(int & loaded, int & compiled);
+
+	/*
+	Defines a shader and returns its identifier
+	@param const char * source The source code of the shader
+	@param GLenum type The requested type (GL_VERTEX_SHADER or GL_FRAGMENT_SHADER)
+	@return GLuint The identifier of the shader
+	*/
+	static GLuint GetShader(const char * source, GLenum type);
+
+	/*
+	Compiles the sources and links the program.
+	@param const char * vertexSource The source code of the vertex shader
+	@param const char * fragmentSource The source code of the fragment shader
+	@return bool If the program was linked
+	*/
+	bool Link(const char * vertexSource, const char * fragmentSource);
+
+	/*
+	Loads the program from the shader binary cache.
+	@param const std::string & path The path of the cache file
+	@param const std::string & key The sources and the driver the binary must have been stored with
+	@return bool If the program was loaded (false if there is no binary, it does not match or the driver rejects it)
+	*/
+	bool LoadBinary(const std::string & path, const std::string & key);
+
+	/*
+	Indicates a drawable no longer uses the program. The program is deleted when no drawable uses it.
+	@param ShaderProgram * program The pointer to the program (NULL is ignored)
+	*/
+	static void Release(ShaderProgram * program);
+
+	/*
+	Stores the linked program in the shader binary cache.
+	@param const std::string & path The path of the cache file
+	@param const std::string & key The sources and the driver of the binary
+	*/
+	void SaveBinary(const std::string & path, const std::string & key);
+
+	/*
+	Enables or disables the shader binary cache for the programs created afterwards (it is enabled by default).
+	@param bool enabled If the cache is used
+	*/
+	static void SetBinaryCache(bool enabled);
+
+	/*
+	Sets the directory where the files of the shader binary cache are stored, for the programs created afterwards (by default
+	they are stored in the working directory).
+	@param const std::string & directory The path of the directory (empty for the working directory)
+	*/
+	static void SetCacheDirectory(const std::string & directory);
+
+};
+
+#endif
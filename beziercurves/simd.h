@@ -0,0 +1,94 @@
+#pragma once
+
+#ifndef _SIMD_H_
+#define _SIMD_H_
+
+// Select the widest instruction set enabled by the compiler
+// NOTE: MSVC defines __AVX__ with /arch:AVX (or /arch:AVX2) and always supports SSE2 on x64. The Release configurations are
+// built with /arch:AVX2 (4 lanes with fused multiply-add), the Debug ones keep the SSE2 baseline (2 lanes)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SIMD_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SIMD_SSE2
+#endif
+
+// Fused multiply-add is available together with AVX2 on MSVC and with -mfma on GCC/Clang
+#if defined(SIMD_AVX) && (defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__)))
+#define SIMD_FMA
+#endif
+
+/*
+Thin wrappers over the SIMD registers of doubles, so kernels are written once for AVX, SSE2 or plain scalar code.
+*/
+namespace Simd
+{
+
+#if defined(SIMD_AVX)
+
+	// The register holding the lanes
+	typedef __m256d Double;
+
+	// The number of doubles processed per instruction
+	const int LANES = 4;
+
+	inline Double Set1(double v) { return _mm256_set1_pd(v); }
+	inline Double Load(const double * p) { return _mm256_loadu_pd(p); }
+	inline void Store(double * p, Double a) { _mm256_storeu_pd(p, a); }
+	inline Double Add(Double a, Double b) { return _mm256_add_pd(a, b); }
+	inline Double Sub(Double a, Double b) { return _mm256_sub_pd(a, b); }
+	inline Double Mul(Double a, Double b) { return _mm256_mul_pd(a, b); }
+	inline Double Div(Double a, Double b) { return _mm256_div_pd(a, b); }
+	inline Double Min(Double a, Double b) { return _mm256_min_pd(a, b); }
+	inline Double Max(Double a, Double b) { return _mm256_max_pd(a, b); }
+
+#if defined(SIMD_FMA)
+	inline Double MulAdd(Double a, Double b, Double c) { return _mm256_fmadd_pd(a, b, c); }
+#else
+	inline Double MulAdd(Double a, Double b, Double c) { return _mm256_add_pd(_mm256_mul_pd(a, b), c); }
+#endif
+
+#elif defined(SIMD_SSE2)
+
+	// The register holding the lanes
+	typedef __m128d Double;
+
+	// The number of doubles processed per instruction
+	const int LANES = 2;
+
+	inline Double Set1(double v) { return _mm_set1_pd(v); }
+	inline Double Load(const double * p) { return _mm_loadu_pd(p); }
+	inline void Store(double * p, Double a) { _mm_storeu_pd(p, a); }
+	inline Double Add(Double a, Double b) { return _mm_add_pd(a, b); }
+	inline Double Sub(Double a, Double b) { return _mm_sub_pd(a, b); }
+	inline Double Mul(Double a, Double b) { return _mm_mul_pd(a, b); }
+	inline Double Div(Double a, Double b) { return _mm_div_pd(a, b); }
+	inline Double Min(Double a, Double b) { return _mm_min_pd(a, b); }
+	inline Double Max(Double a, Double b) { return _mm_max_pd(a, b); }
+	inline Double MulAdd(Double a, Double b, Double c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+
+#else
+
+	// The register holding the lanes (plain scalar code)
+	typedef double Double;
+
+	// The number of doubles processed per instruction
+	const int LANES = 1;
+
+	inline Double Set1(double v) { return v; }
+	inline Double Load(const double * p) { return *p; }
+	inline void Store(double * p, Double a) { *p = a; }
+	inline Double Add(Double a, Double b) { return a + b; }
+	inline Double Sub(Double a, Double b) { return a - b; }
+	inline Double Mul(Double a, Double b) { return a * b; }
+	inline Double Div(Double a, Double b) { return a / b; }
+	inline Double Min(Double a, Double b) { return a < b ? a : b; }
+	inline Double Max(Double a, Double b) { return a > b ? a : b; }
+	inline Double MulAdd(Double a, Double b, Double c) { return (a * b) + c; }
+
+#endif
+
+}
+
+#endif
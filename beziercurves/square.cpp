@@ -5,9 +5,6 @@ Square::Square(double size) :
 	_size((double)size), 
 	_halfSize(_size / 2.0)
 {
-	// Define the shader program for the polygon representing the square
-	DefineShaderProgram();
-
 	// Initialize the vector where the square vertices will be stored
 	std::vector<Point *> * points = new std::vector<Point *>();
 
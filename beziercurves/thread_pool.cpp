@@ -0,0 +1,241 @@
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(int nThreads) :
+	_task(NULL),
+	_chunkSize(1),
+	_generation(0),
+	_busyWorkers(0),
+	_stopping(false)
+{
+	// Use the number of cores if no number of threads is given
+	if (nThreads < 1)
+	{
+		nThreads = (int)std::thread::hardware_concurrency();
+		nThreads = (nThreads < 1) ? 1 : nThreads;
+	}
+
+	// Create the ranges of every thread (the mutexes cannot be moved, so the vector is created with its final size)
+	std::vector<WorkRange>(nThreads).swap(_ranges);
+	for (int i = 0; i < nThreads; i += 1)
+	{
+		_ranges[i]._begin = 0;
+		_ranges[i]._end = 0;
+	}
+
+	// Start the workers (the calling thread is the remaining one)
+	for (int i = 1; i < nThreads; i += 1)
+	{
+		_workers.push_back(std::thread(&ThreadPool::WorkerLoop, this, i));
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	// Indicate the workers must stop and wake them up
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stopping = true;
+	}
+	_startCondition.notify_all();
+
+	// Wait for every worker
+	int nWorkers = _workers.size();
+	for (int i = 0; i < nWorkers; i += 1)
+	{
+		_workers[i].join();
+	}
+}
+
+void ThreadPool::ParallelFor(int count, int chunkSize, const std::function<void(int, int)> & task)
+{
+	// If there is nothing to run then exit the function
+	if (count < 1)
+	{
+		return;
+	}
+
+	// Run the loop on the calling thread if there are no workers or a single chunk
+	chunkSize = (chunkSize < 1) ? 1 : chunkSize;
+	if (_workers.empty() || count <= chunkSize)
+	{
+		task(0, count);
+		return;
+	}
+
+	// Give every thread an equal part of the indices
+	int nThreads = Size();
+	std::vector<int> bounds(nThreads + 1);
+	for (int i = 0; i <= nThreads; i += 1)
+	{
+		bounds[i] = (int)(((long long)count * i) / nThreads);
+	}
+
+	// Run the loop
+	Run(bounds, chunkSize, task);
+}
+
+void ThreadPool::ParallelFor(int count, const double * costs, const std::function<void(int, int)> & task)
+{
+	// If there is nothing to run then exit the function
+	if (count < 1)
+	{
+		return;
+	}
+
+	// Run the loop on the calling thread if there are no workers or a single index
+	if (_workers.empty() || count == 1)
+	{
+		task(0, count);
+		return;
+	}
+
+	// Get the total cost
+	double total = 0.0;
+	for (int i = 0; i < count; i += 1)
+	{
+		total += costs[i];
+	}
+
+	// Give every thread the indices whose accumulated cost falls within its share of the total
+	int nThreads = Size();
+	std::vector<int> bounds(nThreads + 1, count);
+	bounds[0] = 0;
+	double accumulated = 0.0;
+	int thread = 1;
+	for (int i = 0; i < count && thread < nThreads; i += 1)
+	{
+		while (thread < nThreads && accumulated >= (total * thread) / nThreads)
+		{
+			bounds[thread] = i;
+			thread += 1;
+		}
+		accumulated += costs[i];
+	}
+
+	// Run the loop
+	Run(bounds, 1, task);
+}
+
+void ThreadPool::Run(const std::vector<int> & bounds, int chunkSize, const std::function<void(int, int)> & task)
+{
+	// Publish the loop and wake up the workers
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		int nThreads = Size();
+		for (int i = 0; i < nThreads; i += 1)
+		{
+			std::lock_guard<std::mutex> rangeLock(_ranges[i]._mutex);
+			_ranges[i]._begin = bounds[i];
+			_ranges[i]._end = bounds[i + 1];
+		}
+		_task = &task;
+		_chunkSize = chunkSize;
+		_busyWorkers = _workers.size();
+		_generation += 1;
+	}
+	_startCondition.notify_all();
+
+	// Run chunks on the calling thread as well
+	RunChunks(0);
+
+	// Wait for the workers to finish their last chunks
+	std::unique_lock<std::mutex> lock(_mutex);
+	_finishCondition.wait(lock, [this]() { return _busyWorkers == 0; });
+	_task = NULL;
+}
+
+void ThreadPool::RunChunks(int thread)
+{
+	// Take chunks from the front of the own range, and steal when it is empty
+	WorkRange & range = _ranges[thread];
+	while (true)
+	{
+		int first, last;
+		{
+			std::lock_guard<std::mutex> lock(range._mutex);
+			first = range._begin;
+			last = (first + _chunkSize < range._end) ? first + _chunkSize : range._end;
+			range._begin = last;
+		}
+
+		// If the range is empty then steal, and stop if there is nothing left to steal
+		if (first >= last)
+		{
+			if (!Steal(thread))
+			{
+				return;
+			}
+			continue;
+		}
+
+		(*_task)(first, last);
+	}
+}
+
+int ThreadPool::Size() const
+{
+	return (int)_workers.size() + 1;
+}
+
+bool ThreadPool::Steal(int thread)
+{
+	// Visit the other threads, starting from the next one
+	int nThreads = Size();
+	for (int k = 1; k < nThreads; k += 1)
+	{
+		// Take the back half of the range of the victim
+		WorkRange & victim = _ranges[(thread + k) % nThreads];
+		int first, last;
+		{
+			std::lock_guard<std::mutex> lock(victim._mutex);
+			int remaining = victim._end - victim._begin;
+			if (remaining < 1)
+			{
+				continue;
+			}
+			last = victim._end;
+			first = last - ((remaining + 1) / 2);
+			victim._end = first;
+		}
+
+		// Make the stolen indices the range of the thread
+		WorkRange & range = _ranges[thread];
+		std::lock_guard<std::mutex> lock(range._mutex);
+		range._begin = first;
+		range._end = last;
+		return true;
+	}
+
+	// Every range is empty
+	return false;
+}
+
+void ThreadPool::WorkerLoop(int thread)
+{
+	// The number of the last loop run by the worker
+	int lastGeneration = 0;
+
+	while (true)
+	{
+		// Wait for a new loop or for the pool to stop
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_startCondition.wait(lock, [this, lastGeneration]() { return _stopping || _generation != lastGeneration; });
+			if (_stopping)
+			{
+				return;
+			}
+			lastGeneration = _generation;
+		}
+
+		// Run chunks of the loop
+		RunChunks(thread);
+
+		// Indicate the worker finished the loop
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_busyWorkers -= 1;
+		}
+		_finishCondition.notify_one();
+	}
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#ifndef _THREAD_POOL_H_
+#define _THREAD_POOL_H_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+The range of indices of a parallel loop owned by a thread. The owner takes chunks from its front, and threads without work
+steal the back half of it.
+*/
+struct WorkRange
+{
+	// The mutex protecting the range
+	std::mutex _mutex;
+
+	// The first index of the range
+	int _begin;
+
+	// The last index of the range (exclusive)
+	int _end;
+};
+
+/*
+The class representing a fixed set of worker threads running the chunks of parallel loops. The calling thread also runs chunks,
+so a pool with no workers runs every loop on the calling thread. The indices of every loop are split among the threads (evenly,
+or by the given costs), and every thread runs the chunks of its own range before stealing from the others.
+*/
+class ThreadPool
+{
+
+public:
+
+	// The worker threads
+	std::vector<std::thread> _workers;
+
+	// The ranges of the current loop, one per thread (the first one belongs to the calling thread)
+	std::vector<WorkRange> _ranges;
+
+	// The mutex protecting the current loop
+	std::mutex _mutex;
+
+	// The condition notifying the workers there is a new loop (or the pool is stopping)
+	std::condition_variable _startCondition;
+
+	// The condition notifying the calling thread every worker finished the current loop
+	std::condition_variable _finishCondition;
+
+	// The task of the current loop, it receives the first and the last (exclusive) indices of a chunk
+	const std::function<void(int, int)> * _task;
+
+	// The number of indices per chunk of the current loop
+	int _chunkSize;
+
+	// The number of the current loop, it increases every time a loop starts
+	int _generation;
+
+	// The number of workers still running the current loop
+	int _busyWorkers;
+
+	// Indicates whether the workers must stop
+	bool _stopping;
+
+	/*
+	Constructor of the class. Starts the worker threads.
+	@param int nThreads The total number of threads running loops, including the calling one (0 uses the number of cores)
+	*/
+	ThreadPool(int nThreads = 0);
+
+	/*
+	Destructor of the class. Stops and joins the worker threads.
+	*/
+	~ThreadPool();
+
+	/*
+	Runs the task over the indices [0, count) split in chunks, and returns once every chunk has been run. Every thread starts
+	with an equal part of the indices.
+	NOTE: Only one loop runs at a time, so the task must not start another loop on the same pool.
+	@param int count The number of indices
+	@param int chunkSize The number of indices per chunk (at least 1)
+	@param const std::function<void(int, int)> & task The task, it receives the first and the last (exclusive) indices of a chunk
+	*/
+	void ParallelFor(int count, int chunkSize, const std::function<void(int, int)> & task);
+
+	/*
+	Runs the task over the indices [0, count) one index at a time, and returns once every index has been run. Every thread starts
+	with a part of the indices of about the same total cost, so a few expensive indices do not end up in the same thread.
+	NOTE: Only one loop runs at a time, so the task must not start another loop on the same pool.
+	@param int count The number of indices
+	@param const double * costs The estimated cost of every index
+	@param const std::function<void(int, int)> & task The task, it receives the first and the last (exclusive) indices of a chunk
+	*/
+	void ParallelFor(int count, const double * costs, const std::function<void(int, int)> & task);
+
+	/*
+	Runs the chunks of the given ranges on the calling thread and the workers.
+	@param const std::vector<int> & bounds The first index of the range of every thread, followed by the total number of indices
+	@param int chunkSize The number of indices per chunk
+	@param const std::function<void(int, int)> & task The task
+	*/
+	void Run(const std::vector<int> & bounds, int chunkSize, const std::function<void(int, int)> & task);
+
+	/*
+	Takes and runs chunks of the current loop until there are no chunks left, first from the range of the thread and then from
+	the ranges of the others.
+	@param int thread The index of the thread (0 for the calling thread)
+	*/
+	void RunChunks(int thread);
+
+	/*
+	Returns the total number of threads running loops, including the calling one.
+	@return int The number of threads
+	*/
+	int Size() const;
+
+	/*
+	Moves the back half of the range of another thread into the range of the given one.
+	@param int thread The index of the thread stealing
+	@return bool If any index was stolen (false if every range is empty)
+	*/
+	bool Steal(int thread);
+
+	/*
+	The loop of every worker thread, it waits for new loops and runs their chunks.
+	@param int thread The index of the thread
+	*/
+	void WorkerLoop(int thread);
+
+};
+
+#endif
@@ -1,6 +1,212 @@
 #include "utils.h"
+#include <algorithm>
 #include <sstream>
 #include <iterator>
+#include <utility>
+#include <stdlib.h>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+void * Utils::AlignedAlloc(size_t size, size_t alignment)
+{
+#ifdef _WIN32
+	return _aligned_malloc(size, alignment);
+#else
+	void * block = NULL;
+	if (posix_memalign(&block, alignment, size) != 0) 
+	{
+		return NULL;
+	}
+	return block;
+#endif
+}
+
+void Utils::AlignedFree(void * block)
+{
+#ifdef _WIN32
+	_aligned_free(block);
+#else
+	free(block);
+#endif
+}
+
+void Utils::BernsteinRoots(const double * coefficients, int nCoefficients, double tolerance, std::vector<double> & roots)
+{
+	// If there are no coefficients then there are no roots
+	if (nCoefficients < 1)
+	{
+		return;
+	}
+
+	// The number of roots stored before the call, only the ones appended by this call are compared
+	size_t nPrevious = roots.size();
+
+	// The coefficients of the pending intervals (one after the other) and their ends
+	static thread_local std::vector<double> stackCoefficients;
+	static thread_local std::vector<double> stackEnds;
+	stackCoefficients.assign(coefficients, coefficients + nCoefficients);
+	stackEnds.clear();
+	stackEnds.push_back(0.0);
+	stackEnds.push_back(1.0);
+
+	// The first root is at 0 if the first coefficient is zero
+	if (coefficients[0] == 0.0)
+	{
+		roots.push_back(0.0);
+	}
+
+	// Process the pending intervals from left to right, so the roots are found in increasing order
+	while (!stackEnds.empty())
+	{
+		// Take the last interval
+		double b = stackEnds.back();
+		stackEnds.pop_back();
+		double a = stackEnds.back();
+		stackEnds.pop_back();
+		size_t offset = stackCoefficients.size() - nCoefficients;
+		double * c = stackCoefficients.data() + offset;
+
+		// Count the sign changes of the coefficients (ignoring zeros)
+		int signChanges = 0;
+		double lastSign = 0.0;
+		for (int i = 0; i < nCoefficients; i += 1)
+		{
+			double sign = (c[i] > 0.0) ? 1.0 : ((c[i] < 0.0) ? -1.0 : 0.0);
+			if (sign != 0.0)
+			{
+				signChanges += (lastSign != 0.0 && sign != lastSign) ? 1 : 0;
+				lastSign = sign;
+			}
+		}
+
+		// Get the value at the right end, it is a root if it is zero (unless it is the end of the domain, added at the end)
+		double right = c[nCoefficients - 1];
+
+		// If the coefficients do not change sign then there is no root inside of the interval
+		if (signChanges == 0)
+		{
+			stackCoefficients.resize(offset);
+			if (right == 0.0 && b < 1.0)
+			{
+				roots.push_back(b);
+			}
+			continue;
+		}
+
+		// If there is a single root (or the interval is small enough) then refine it using the Illinois method
+		if ((signChanges == 1 && c[0] * right < 0.0) || b - a <= tolerance)
+		{
+			// The bracket of the root in the local parameter of the interval, and the values at its ends
+			double lo = 0.0;
+			double hi = 1.0;
+			double fLo = c[0];
+			double fHi = right;
+			double s = 0.5;
+			int side = 0;
+
+			// The values of the DeCasteljau triangle (stack storage for typical degrees)
+			double values[64];
+			std::vector<double> largeValues;
+			double * v = values;
+			if (nCoefficients > 64)
+			{
+				largeValues.resize(nCoefficients);
+				v = largeValues.data();
+			}
+
+			for (int k = 0; k < 100 && (hi - lo) * (b - a) > tolerance && fLo * fHi < 0.0; k += 1)
+			{
+				// Take the secant step and evaluate the polynomial there (DeCasteljau over a copy of the coefficients)
+				s = ((lo * fHi) - (hi * fLo)) / (fHi - fLo);
+				for (int i = 0; i < nCoefficients; i += 1)
+				{
+					v[i] = c[i];
+				}
+				for (int m = nCoefficients - 1; m > 0; m -= 1)
+				{
+					for (int i = 0; i < m; i += 1)
+					{
+						v[i] = ((1.0 - s) * v[i]) + (s * v[i + 1]);
+					}
+				}
+				double f = v[0];
+
+				// Shrink the bracket, halving the value of the end kept twice in a row
+				if (f == 0.0)
+				{
+					lo = hi = s;
+					break;
+				}
+				if (f * fHi < 0.0)
+				{
+					lo = s;
+					fLo = f;
+					fHi = (side == 1) ? 0.5 * fHi : fHi;
+					side = 1;
+				}
+				else
+				{
+					hi = s;
+					fHi = f;
+					fLo = (side == -1) ? 0.5 * fLo : fLo;
+					side = -1;
+				}
+			}
+
+			// Store the root (skipping the end of the domain, added at the end)
+			double root = a + (0.5 * (lo + hi) * (b - a));
+			if (root < 1.0 && (roots.size() == nPrevious || root > roots.back()))
+			{
+				roots.push_back(root);
+			}
+			stackCoefficients.resize(offset);
+			if (right == 0.0 && b < 1.0 && b > root)
+			{
+				roots.push_back(b);
+			}
+			continue;
+		}
+
+		// Otherwise split the interval in half, storing the left half in place and the right half after it
+		stackCoefficients.resize(offset + (2 * nCoefficients));
+		c = stackCoefficients.data() + offset;
+		double * r = c + nCoefficients;
+		for (int i = 0; i < nCoefficients; i += 1)
+		{
+			r[i] = c[i];
+		}
+		for (int k = 1; k < nCoefficients; k += 1)
+		{
+			for (int i = nCoefficients - 1; i >= k; i -= 1)
+			{
+				c[i] = 0.5 * (c[i - 1] + c[i]);
+			}
+			for (int i = 0; i < nCoefficients - k; i += 1)
+			{
+				r[i] = 0.5 * (r[i] + r[i + 1]);
+			}
+		}
+
+		// Push the right half first, so the left one is processed next
+		// NOTE: The halves are swapped in the buffer, since the last coefficients belong to the last interval pushed
+		for (int i = 0; i < nCoefficients; i += 1)
+		{
+			std::swap(c[i], r[i]);
+		}
+		double middle = 0.5 * (a + b);
+		stackEnds.push_back(middle);
+		stackEnds.push_back(b);
+		stackEnds.push_back(a);
+		stackEnds.push_back(middle);
+	}
+
+	// The last root is at 1 if the last coefficient is zero
+	if (coefficients[nCoefficients - 1] == 0.0 && (roots.size() == nPrevious || roots.back() < 1.0))
+	{
+		roots.push_back(1.0);
+	}
+}
 
 std::vector<Point*>* Utils::ConvexHull(std::vector<Point*>* points)
 {
@@ -63,6 +269,51 @@ std::vector<Point*>* Utils::ConvexHull(std::vector<Point*>* points)
 	return lower;
 }
 
+void Utils::ConvexHull(const ControlPoints * points, std::vector<int> & indices, std::vector<int> & hull)
+{
+	// Remove the previous vertices
+	hull.clear();
+
+	// A subset with less than two points is its own hull
+	int nPoints = indices.size();
+	if (nPoints < 2)
+	{
+		hull.assign(indices.begin(), indices.end());
+		return;
+	}
+
+	// Sort the indices by the X coordinates of their points, and by their Y coordinates when they are equal
+	const ControlScalar * x = points->_x;
+	const ControlScalar * y = points->_y;
+	std::sort(indices.begin(), indices.end(), [x, y](int a, int b) { return x[a] < x[b] || (x[a] == x[b] && y[a] < y[b]); });
+
+	// Build the lower vertices from left to right
+	for (int i = 0; i < nPoints; i += 1)
+	{
+		int p = indices[i];
+		while (hull.size() >= 2 && IsLeft(x[p], y[p], x[hull[hull.size() - 2]], y[hull[hull.size() - 2]], x[hull.back()], y[hull.back()]) <= 0)
+		{
+			hull.pop_back();
+		}
+		hull.push_back(p);
+	}
+
+	// Build the upper vertices from right to left (the last lower vertex is the first upper one)
+	size_t lowerSize = hull.size();
+	for (int i = nPoints - 2; i >= 0; i -= 1)
+	{
+		int p = indices[i];
+		while (hull.size() > lowerSize && IsLeft(x[p], y[p], x[hull[hull.size() - 2]], y[hull[hull.size() - 2]], x[hull.back()], y[hull.back()]) <= 0)
+		{
+			hull.pop_back();
+		}
+		hull.push_back(p);
+	}
+
+	// Remove the last vertex (it is the first one)
+	hull.pop_back();
+}
+
 void Utils::DeletePointVector(std::vector<Point*>* points)
 {
 	// Get the number of points in the vector
@@ -83,6 +334,11 @@ double Utils::IsLeft(Point * p, Point * A, Point * B)
 	return (A->x - p->x) * (B->y - p->y) - (B->x - p->x) * (A->y - p->y);
 }
 
+double Utils::IsLeft(double px, double py, double ax, double ay, double bx, double by)
+{
+	return (ax - px) * (by - py) - (bx - px) * (ay - py);
+}
+
 Point * Utils::lerp(Point * A, Point * B, double t)
 {
 	// Initialize the new point
@@ -95,6 +351,7 @@ Point * Utils::lerp(Point * A, Point * B, double t)
 	p->x = (_t * A->x) + (t * B->x);
 	p->y = (_t * A->y) + (t * B->y);
 	p->z = (_t * A->z) + (t * B->z);
+	p->w = (_t * A->w) + (t * B->w);
 
 	// Return the pointer to the interpolated point
 	return p;
@@ -108,42 +365,8 @@ double Utils::map(double value, double start1, double stop1, double start2, doub
 
 void Utils::Sort(std::vector<Point*>* points)
 {
-	// Get the number of points
-	int nPoints = points->size();
-
-	// Traverse through the points and run BubbleSort
-	// NOTE: I know it is not optimal but given the nature of this assignment I don't see why complicating with fancier methods
-	for (int i = 0; i < nPoints; i += 1) 
-	{
-		for (int j = i + 1; j < nPoints; j += 1) 
-		{
-			// Get the reference to the point at index i
-			Point * pi = points->at(i);
-
-			// Get the reference to the point at index j
-			Point * pj = points->at(j);
-
-			// Check if pi.x is greater than pj.x
-			if (pi->x > pj->x) 
-			{
-				// Swap pi with pj
-				Point * pt = pi;
-				points->at(i) = points->at(j);
-				points->at(j) = pt;
-			}
-			else if (pi->x == pj->x) 
-			{
-				// Check if pi.y is greater than pj.y
-				if (pi->y > pj->y) 
-				{
-					// Swap pi with pj
-					Point * pt = pi;
-					points->at(i) = points->at(j);
-					points->at(j) = pt;
-				}
-			}
-		}
-	}
+	// Sort the points by their X coordinates, and by their Y coordinates when they are equal
+	std::sort(points->begin(), points->end(), [](Point * a, Point * b) { return a->x < b->x || (a->x == b->x && a->y < b->y); });
 }
 
 std::vector<std::string> Utils::split(const std::string & s, char delim)
@@ -3,11 +3,39 @@
 #ifndef _UTILS_H_
 #define _UTILS_H_
 
+#include "control_points.h"
 #include "point.h"
 #include <vector>
 
 namespace Utils 
 {
+	/*
+	Allocates a block of memory aligned to the given number of bytes.
+	@param size_t size The size (in bytes) of the block
+	@param size_t alignment The alignment (in bytes) of the block. It must be a power of two
+	@return void * The pointer to the aligned block. It must be released using AlignedFree
+	*/
+	void * AlignedAlloc(size_t size, size_t alignment);
+
+	/*
+	Releases a block of memory allocated with AlignedAlloc.
+	@param void * block The pointer to the aligned block
+	*/
+	void AlignedFree(void * block);
+
+	/*
+	Finds the roots in [0, 1] of a polynomial in Bernstein form. Intervals are split in half (DeCasteljau at 0.5) until their 
+	coefficients change sign at most once (by the variation diminishing property there is no root when they do not change sign, 
+	and a single one when they change sign once with opposite end values), then the single roots are refined with the Illinois 
+	variant of regula falsi.
+	NOTE: Roots where the polynomial does not change sign (e.g. double roots) are found only if they are at a split point or an end.
+	@param const double * coefficients The Bernstein coefficients of the polynomial
+	@param int nCoefficients The number of coefficients (the degree plus one)
+	@param double tolerance The parametric tolerance of the roots
+	@param std::vector<double> & roots The vector where the roots are appended in increasing order
+	*/
+	void BernsteinRoots(const double * coefficients, int nCoefficients, double tolerance, std::vector<double> & roots);
+
 	/*
 	Returns the vector with the points of the convex hull from the given points. 2D convex hull 
 	is calculated using the Monotone chain method as described in: 
@@ -18,6 +46,16 @@ namespace Utils
 	*/
 	std::vector<Point *> * ConvexHull(std::vector<Point *> * points);
 
+	/*
+	Calculates the convex hull of a subset of control points using the Monotone chain method. Only the indices of the control 
+	points are sorted, so no point is copied.
+	NOTE: Collinear points are left out of the hull. A subset with less than two points is its own hull.
+	@param const ControlPoints * points The control points
+	@param std::vector<int> & indices The indices of the control points of the subset (they are sorted in place)
+	@param std::vector<int> & hull The vector where the indices of the vertices of the hull are stored in counterclockwise order
+	*/
+	void ConvexHull(const ControlPoints * points, std::vector<int> & indices, std::vector<int> & hull);
+
 	/*
 	Deletes the content and the vector from memory.
 	@param std::vector<Point *> * points
@@ -33,6 +71,18 @@ namespace Utils
 	*/
 	double IsLeft(Point * p, Point * A, Point * B);
 
+	/*
+	Tests whether a point p is left, on or right of a line defined by A and B (see IsLeft).
+	@param double px The X coordinate of the point to be tested
+	@param double py The Y coordinate of the point to be tested
+	@param double ax The X coordinate of the first point defining the line
+	@param double ay The Y coordinate of the first point defining the line
+	@param double bx The X coordinate of the second point defining the line
+	@param double by The Y coordinate of the second point defining the line
+	@return >0 for p left of the line through A and B, =0 for p on the line, <0 for p right of the line
+	*/
+	double IsLeft(double px, double py, double ax, double ay, double bx, double by);
+
 	/*
 	Returns the linear interpolation between two points and a given parameter.
 	@param Point * A
@@ -53,7 +103,7 @@ namespace Utils
 	double map(double value, double start1, double stop1, double start2, double stop2);
 
 	/*
-	Sorts the given vector of points
+	Sorts the given vector of points by their X coordinates (and their Y coordinates when they are equal)
 	@param std::vector<Point *> * points
 	*/
 	void Sort(std::vector<Point *> * points);